@@ -65,6 +65,12 @@ function pathfinder.init(max_nodes, max_gameobject_nodes, max_edges_per_node, he
 ---Shutdown the pathfinding system and free all resources.
 function pathfinder.shutdown() end
 
+---Get cache, spatial index and query statistics.
+---stats.queries.last_frame covers the queries made during the last completed frame, stats.queries.total covers all queries since init.
+---Query times are in microseconds.
+---@return table stats Table with path_cache, smoothed_path_cache, distance_cache, spatial_index and queries fields
+function pathfinder.get_stats() end
+
 ---Add a single node to the pathfinding graph.
 ---@param x number X coordinate of the node
 ---@param y number Y coordinate of the node
@@ -114,16 +120,30 @@ function pathfinder.add_edges(edges) end
 ---@param bidirectional? boolean If true, removes edges in both directions
 function pathfinder.remove_edge(from_node_id, to_node_id, bidirectional) end
 
+---Serialize a set of nodes and the edges between them into a binary graph snapshot.
+---Removed node IDs are not detected: their stale positions are saved and load back as live nodes.
+---@param node_ids number[] Nodes to save (edges to nodes outside this list are dropped)
+---@return string data Binary graph snapshot
+function pathfinder.save_graph(node_ids) end
+
+---Add the nodes and edges of a binary graph snapshot to the current graph.
+---Nodes are all-or-nothing: on an invalid snapshot or a full graph nothing is added and node_ids is nil.
+---@param data string Binary graph snapshot from save_graph
+---@return number[]|nil node_ids Created node IDs in snapshot order, nil on failure
+---@return number failed_edge_count Number of edges that could not be added
+function pathfinder.load_graph(data) end
+
 ---Find a path between two nodes using A* algorithm.
 ---@param start_node_id number Starting node ID
 ---@param goal_node_id number Goal node ID
 ---@param max_path_length number Maximum path length to search
 ---@param smooth_id? number|nil Optional smoothing configuration ID (default: 0 = no smoothing)
+---@param flat? boolean Return path as a flat number array: { x, y, id, ... } or { x, y, ... } when smoothed
 ---@return number path_length Number of waypoints in the path
 ---@return number status PathStatus code indicating success or error
 ---@return string status_text Human-readable status message
 ---@return PathNode[] path Array of waypoints (positions with optional node IDs)
-function pathfinder.find_node_to_node(start_node_id, goal_node_id, max_path_length, smooth_id) end
+function pathfinder.find_node_to_node(start_node_id, goal_node_id, max_path_length, smooth_id, flat) end
 
 ---Find a path from an arbitrary position (not on graph) to a goal node.
 ---Projects the start position onto the nearest graph edge and pathfinds from there.
@@ -132,12 +152,13 @@ function pathfinder.find_node_to_node(start_node_id, goal_node_id, max_path_leng
 ---@param goal_node_id number Goal node ID
 ---@param max_path_length number Maximum path length to search
 ---@param smooth_id? number|nil Optional smoothing configuration ID (default: 0 = no smoothing)
+---@param flat? boolean Return path as a flat number array: { x, y, id, ... } or { x, y, ... } when smoothed
 ---@return number path_length Number of waypoints in the path
 ---@return number status PathStatus code indicating success or error
 ---@return string status_text Human-readable status message
 ---@return vector3 entry_point Position where the path enters the graph
 ---@return PathNode[] path Array of waypoints (positions with optional node IDs)
-function pathfinder.find_projected_to_node(x, y, goal_node_id, max_path_length, smooth_id) end
+function pathfinder.find_projected_to_node(x, y, goal_node_id, max_path_length, smooth_id, flat) end
 
 ---Find a path from a start node to an arbitrary position (not on graph).
 ---Projects the target position onto the nearest graph edge and pathfinds to there.
@@ -146,12 +167,13 @@ function pathfinder.find_projected_to_node(x, y, goal_node_id, max_path_length,
 ---@param y number Y coordinate of target position
 ---@param max_path_length number Maximum path length to search
 ---@param smooth_id? number|nil Optional smoothing configuration ID (default: 0 = no smoothing)
+---@param flat? boolean Return path as a flat number array: { x, y, id, ... } or { x, y, ... } when smoothed
 ---@return number path_length Number of waypoints in the path
 ---@return number status PathStatus code indicating success or error
 ---@return string status_text Human-readable status message
 ---@return vector3 exit_point Position where the path exits the graph
 ---@return PathNode[] path Array of waypoints (positions with optional node IDs)
-function pathfinder.find_node_to_projected(start_node_id, x, y, max_path_length, smooth_id) end
+function pathfinder.find_node_to_projected(start_node_id, x, y, max_path_length, smooth_id, flat) end
 
 ---Find a path from an arbitrary position (not on the graph) to another arbitrary position (not on the graph).
 ---Projects both start and target positions onto the nearest graph edges and pathfinds between them.
@@ -161,20 +183,108 @@ function pathfinder.find_node_to_projected(start_node_id, x, y, max_path_length,
 ---@param target_y number Y coordinate of target position
 ---@param max_path_length number Maximum path length to search
 ---@param smooth_id? number|nil Optional smoothing configuration ID (default: 0 = no smoothing)
+---@param flat? boolean Return path as a flat number array: { x, y, id, ... } or { x, y, ... } when smoothed
 ---@return number path_length Number of waypoints in the path
 ---@return number status PathStatus code indicating success or error
 ---@return string status_text Human-readable status message
 ---@return vector3 entry_point Position where the path enters the graph
 ---@return vector3 exit_point Position where the path exits the graph
 ---@return PathNode[] path Array of waypoints (positions with optional node IDs)
-function pathfinder.find_projected_to_projected(start_x, start_y, target_x, target_y, max_path_length, smooth_id) end
+function pathfinder.find_projected_to_projected(start_x, start_y, target_x, target_y, max_path_length, smooth_id, flat) end
+
+---@class PathRequest
+---@field [1] number Start node ID
+---@field [2] number Goal node ID
+---@field [3] number Maximum path length
+---@field [4] number|nil Optional smoothing configuration ID (default: 0 = no smoothing)
+
+---Solve many node-to-node queries in a single native call.
+---@param requests PathRequest[] Array of { start_node_id, goal_node_id, max_path_length, [smooth_id] } tuples
+---@return number[] results Flat array with status, offset, length for each request
+---@return number[] points Flat array of x, y pairs; offset is the index of the first x of a path
+function pathfinder.find_paths_batch(requests) end
+
+---Find a path using a flow field of the goal: one reverse Dijkstra per goal, then O(path length) per query.
+---Fields are rebuilt on next use after nodes or edges are added or removed (node moves and projected queries do not rebuild them).
+---@param start_node_id number Starting node ID
+---@param goal_node_id number Goal node ID
+---@param max_path_length number Maximum path length
+---@param smooth_id? number|nil Optional smoothing configuration ID (default: 0 = no smoothing)
+---@param flat? boolean Return path as a flat number array: { x, y, id, ... } or { x, y, ... } when smoothed
+---@return number path_length Number of waypoints in the path
+---@return number status PathStatus code indicating success or error
+---@return string status_text Human-readable status message
+---@return PathNode[] path Array of waypoints (positions with optional node IDs)
+function pathfinder.find_flow_field_path(start_node_id, goal_node_id, max_path_length, smooth_id, flat) end
+
+---Set how many flow fields (goals) are kept at the same time (default 4). Clears all existing fields.
+---@param capacity number Maximum number of flow fields
+function pathfinder.set_flow_field_capacity(capacity) end
+
+---Find a path between two nodes with bidirectional A* (searches from both ends until they meet).
+---Shortest only when every edge cost is at least the distance between its nodes. Shares the path cache with find_node_to_node. The edge arrays are shared with flow fields and rebuilt on next use after nodes or edges are added or removed (not after node moves).
+---@param start_node_id number Starting node ID
+---@param goal_node_id number Goal node ID
+---@param max_path_length number Maximum path length
+---@param smooth_id? number|nil Optional smoothing configuration ID (default: 0 = no smoothing)
+---@param flat? boolean Return path as a flat number array: { x, y, id, ... } or { x, y, ... } when smoothed
+---@return number path_length Number of waypoints in the path
+---@return number status PathStatus code indicating success or error
+---@return string status_text Human-readable status message
+---@return PathNode[] path Array of waypoints (positions with optional node IDs)
+function pathfinder.find_bidirectional_path(start_node_id, goal_node_id, max_path_length, smooth_id, flat) end
+
+---Use bidirectional search in find_node_to_node, find_paths_batch and request_path when the start-goal distance is at least `distance`.
+---@param distance number Minimum start-goal distance, 0 to disable (default)
+function pathfinder.set_bidirectional_threshold(distance) end
+
+---Queue a node-to-node query, solved during the extension update.
+---@param start_node_id number Starting node ID
+---@param goal_node_id number Goal node ID
+---@param max_path_length number Maximum path length to search
+---@param smooth_id number|nil Smoothing configuration ID, nil or 0 for no smoothing
+---@param callback fun(self: any, ticket: number, path_length: number, status: number, status_text: string, path: PathNode[]) Result callback
+---@return number ticket Request ticket, 0 if the request queue is full
+function pathfinder.request_path(start_node_id, goal_node_id, max_path_length, smooth_id, callback) end
+
+---Cancel a queued request. Its callback will not be invoked.
+---@param ticket number Ticket returned by request_path
+---@return boolean cancelled true if the request was still pending
+function pathfinder.cancel_path_request(ticket) end
+
+---Set the maximum number of pending requests (default 128).
+---@param capacity number Maximum number of pending requests
+function pathfinder.set_path_request_capacity(capacity) end
+
+---Limit how many queued requests are solved per update. At least one request is solved every update.
+---@param max_requests? number Maximum requests per update (default: 0 = unlimited)
+---@param max_time? number Time budget per update in microseconds (default: 0 = unlimited)
+function pathfinder.set_path_request_budget(max_requests, max_time) end
+
+---Get the number of queued requests that are not solved yet.
+---@return number count Number of pending requests
+function pathfinder.get_pending_path_request_count() end
+
+---Enable caching of smoothed node paths, keyed on node sequence, node positions, smooth_id and config version.
+---@param max_entries number Maximum number of cached smoothed paths, 0 to disable
+---@param max_points number Maximum points of a single cached smoothed path (longer results are not cached)
+function pathfinder.set_smoothed_path_cache(max_entries, max_points) end
 
 ---Apply path smoothing to a set of waypoints.
 ---@param smooth_id number Smoothing configuration ID (from add_path_smoothing)
 ---@param waypoints PathNode[] Array of waypoint positions
+---@param flat? boolean Return smoothed_path as a flat { x, y, ... } number array
 ---@return number smoothed_length Number of points in smoothed path
 ---@return PathNode[] smoothed_path Array of smoothed positions
-function pathfinder.smooth_path(smooth_id, waypoints) end
+function pathfinder.smooth_path(smooth_id, waypoints, flat) end
+
+---Resample a path into points spaced evenly by distance (first and last points are kept).
+---@param path PathNode[] Array of positions
+---@param spacing number Distance between consecutive output points, must be greater than 0
+---@param flat? boolean Return resampled_path as a flat { x, y, ... } number array
+---@return number resampled_length Number of points in resampled path
+---@return PathNode[] resampled_path Array of evenly spaced positions
+function pathfinder.resample_path(path, spacing, flat) end
 
 ---Create a path smoothing configuration.
 ---@param config PathSmoothConfig Smoothing configuration table
@@ -219,6 +329,11 @@ function pathfinder.pause_gameobject_node(node_id) end
 ---@param node_id number ID of the game object node to resume
 function pathfinder.resume_gameobject_node(node_id) end
 
+---Sync a game object node every `interval` update steps instead of every step.
+---@param node_id number ID of the game object node
+---@param interval number Update steps between syncs (1 = every step, default)
+function pathfinder.set_gameobject_node_update_interval(node_id, interval) end
+
 ---Enable or disable automatic game object node position updates.
 ---@param enabled boolean True to enable automatic updates, false to disable
 function pathfinder.gameobject_update(enabled) end
@@ -10,6 +10,49 @@ namespace pathfinder
 {
     namespace extension
     {
+        // Batch
+        typedef struct PathRequest
+        {
+            uint32_t m_StartNodeId; // Start node ID
+            uint32_t m_GoalNodeId;  // Goal node ID
+            uint32_t m_MaxPath;     // Maximum path length
+            uint32_t m_SmoothId;    // Smoothing config ID (0 = no smoothing)
+        } PathRequest;
+
+        typedef struct PathResult
+        {
+            PathStatus m_Status; // Pathfinding status
+            uint32_t   m_Offset; // Index of the first point in the batch output buffer
+            uint32_t   m_Length; // Number of points (0 if no path)
+        } PathResult;
+
+        // Jobs
+        typedef struct PathJobResult
+        {
+            uint32_t   m_Ticket;   // Ticket returned by submit_path_job
+            PathStatus m_Status;   // Pathfinding status
+            bool       m_Smoothed; // true: points in get_path_job_points(), false: node IDs in get_path_job_nodes()
+            uint32_t   m_Offset;   // Index of the first element in the job output buffer
+            uint32_t   m_Length;   // Number of elements (0 if no path)
+        } PathJobResult;
+
+        // Stats
+        typedef struct QueryStats
+        {
+            uint32_t m_QueryCount;            // Number of find_* queries
+            uint32_t m_SuccessCount;          // Queries that returned SUCCESS
+            uint32_t m_NoPathCount;           // Queries that returned ERROR_NO_PATH
+            uint32_t m_GraphChangedCount;     // Queries that returned ERROR_GRAPH_CHANGED or ERROR_GRAPH_CHANGED_TOO_OFTEN
+            uint32_t m_ErrorCount;            // Queries that returned any other error
+            uint32_t m_SmoothCount;           // Number of smoothing passes
+            uint32_t m_PathLength;            // Sum of raw path lengths of successful queries
+            uint64_t m_SearchTime;            // Total search time in microseconds (projection included)
+            uint64_t m_MaxSearchTime;         // Slowest single search in microseconds
+            uint64_t m_SmoothTime;            // Total smoothing time in microseconds
+            uint32_t m_BidirectionalCount;    // Queries solved by bidirectional search
+            uint32_t m_BidirectionalExpanded; // Nodes expanded by bidirectional searches
+        } QueryStats;
+
         // OPs
         void init();
         void shutdown();
@@ -31,6 +74,7 @@ namespace pathfinder
         void remove_gameobject_node(uint32_t node_id);
         void pause_gameobject_node(uint32_t node_id);
         void resume_gameobject_node(uint32_t node_id);
+        void set_gameobject_node_update_interval(uint32_t node_id, uint32_t update_interval);
 
         // Update
         void set_update_state(bool state);
@@ -43,6 +87,58 @@ namespace pathfinder
         uint32_t get_smooth_sample_segment(uint32_t smooth_id);
         void     smooth_path(uint32_t smooth_id, dmArray<uint32_t>& path, dmArray<Vec2>& smoothed_path);
         void     smooth_path_waypoint(uint32_t smooth_id, dmArray<Vec2>& waypoints, dmArray<Vec2>& smoothed_path);
+        uint32_t resample_path(const dmArray<Vec2>& path, float spacing, dmArray<Vec2>& resampled);
+
+        // Smoothed path cache
+        void     set_smoothed_path_cache(uint32_t max_entries, uint32_t max_points);
+        void     clear_smoothed_path_cache();
+        void     get_smoothed_path_cache_stats(uint32_t& entries, uint32_t& capacity, uint32_t& hits, uint32_t& misses);
+
+        // Flow fields: one reverse Dijkstra per goal, shared by every start node
+        void     set_node_capacity(uint32_t max_nodes);
+        void     bump_topology_version(); // Call after adding or removing nodes or edges
+        void     set_flow_field_capacity(uint32_t capacity);
+        void     clear_flow_fields();
+        uint32_t find_flow_field_path(uint32_t start_node_id, uint32_t goal_node_id, dmArray<uint32_t>& path, uint32_t max_path, PathStatus* status);
+
+        // Bidirectional A*: forward and backward searches over the flow field adjacency.
+        // find_node_path() uses it above the distance threshold and path::find_path() below.
+        void     set_bidirectional_threshold(float distance);
+        uint32_t find_bidirectional_path(uint32_t start_node_id, uint32_t goal_node_id, dmArray<uint32_t>& path, uint32_t max_path, PathStatus* status);
+        uint32_t find_node_path(uint32_t start_node_id, uint32_t goal_node_id, dmArray<uint32_t>& path, uint32_t max_path, PathStatus* status);
+
+        // Graph snapshot: versioned binary blob of node positions and directed edges
+        void     save_graph(const dmArray<uint32_t>& node_ids, dmArray<uint8_t>& out);
+        bool     load_graph(const uint8_t* data, uint32_t size, dmArray<uint32_t>& node_ids, uint32_t& failed_edges); // Nothing is added on failure
+
+        // Stats
+        void              record_query(PathStatus status, uint32_t path_length, uint64_t search_time);
+        void              record_smoothing(uint64_t smooth_time);
+        void              reset_query_stats();
+        const QueryStats& get_frame_query_stats();
+        const QueryStats& get_total_query_stats();
+
+        // Result arena: persistent output buffers, reset every update.
+        // Each getter empties its buffer, so results must be consumed before the next call.
+        dmArray<uint32_t>& get_arena_path();
+        dmArray<Vec2>&     get_arena_waypoints(uint32_t capacity);
+        dmArray<Vec2>&     get_arena_smoothed_path(uint32_t capacity);
+        void               reset_result_arena();
+
+        // Batch
+        void     find_paths_batch(const dmArray<PathRequest>& requests, dmArray<PathResult>& results, dmArray<Vec2>& points);
+
+        // Jobs
+        void                          set_path_job_capacity(uint32_t capacity);
+        uint32_t                      submit_path_job(const PathRequest& request);
+        bool                          cancel_path_job(uint32_t ticket);
+        void                          clear_path_jobs();
+        void                          set_path_job_budget(uint32_t max_jobs, uint32_t max_time);
+        uint32_t                      get_pending_path_job_count();
+        void                          process_path_jobs();
+        const dmArray<PathJobResult>& get_path_job_results();
+        const dmArray<uint32_t>&      get_path_job_nodes();
+        const dmArray<Vec2>&          get_path_job_points();
 
     } // namespace extension
 } // namespace pathfinder
@@ -3,6 +3,7 @@
 
 #include "pathfinder_constants.h"
 #include <cstdint>
+#include <cstring>
 #include "dmarray_include.h"
 
 /**
@@ -19,6 +20,7 @@
  * - Version tracking for cache invalidation
  * - Bulk operations (build, push_many) for efficiency
  * - Inline operations (push, pop, peek) for zero-overhead access
+ * - Optional indexed mode (HeapIndex) for O(log n) decrease_key and O(1) membership
  *
  * Heap Operations:
  * - push(): Insert element, O(log n) - bubble up
@@ -28,6 +30,13 @@
  * - build(): Heapify array, O(n) - Floyd's algorithm
  * - push_many(): Bulk insert, O(n + k log n)
  *
+ * Indexed Heap Operations (HeapBlock + HeapIndex):
+ * - push_indexed(): Insert element and record its slot, O(log n)
+ * - pop_indexed(): Extract minimum and clear its slot, O(log n)
+ * - decrease_key_indexed(): Update priority via position map, O(log n)
+ * - contains(): Open-list membership check, O(1)
+ * - index_clear(): Invalidate all positions (generation bump), O(1)
+ *
  * Version Tracking:
  * - Global version (node/edge) increments on graph changes
  * - Per-node versions track individual node modifications
@@ -60,6 +69,25 @@
  * pathfinder::heap::pool_clear();
  * @endcode
  *
+ * Indexed Usage Pattern:
+ * @code
+ * // Allocate the position map once (sized to max_nodes)
+ * HeapIndex index;
+ * pathfinder::heap::index_init(&index, max_nodes);
+ *
+ * // Per search: O(1) reset, no allocation
+ * pathfinder::heap::index_clear(&index);
+ * pathfinder::heap::push_indexed(&heap, &index, start_node, 0.0f);
+ *
+ * while (!pathfinder::heap::is_empty(&heap)) {
+ *     uint32_t current = pathfinder::heap::pop_indexed(&heap, &index);
+ *     // For each neighbor with improved score:
+ *     pathfinder::heap::push_or_decrease_key(&heap, &index, neighbor, f_score);
+ * }
+ *
+ * pathfinder::heap::index_shutdown(&index);
+ * @endcode
+ *
  * Thread Safety: Not thread-safe. Each heap instance must be used by a single thread.
  * Global version counters are not protected by mutexes.
  */
@@ -134,6 +162,26 @@ namespace pathfinder
             bool     m_AffectsPaths; // Does this node affect any cached paths?
         } NodeVersion;
 
+        /**
+         * @brief Per-node heap position map for the indexed heap mode
+         *
+         * Maps graph node IDs to their current slot in a HeapBlock, so decrease_key
+         * and open-list membership checks no longer need a linear scan of m_Nodes.
+         *
+         * Entries are generation-stamped: a position is only valid if its stamp equals
+         * m_Generation. Bumping m_Generation (index_clear) invalidates the entire map
+         * in O(1), so the arrays are allocated once with max_nodes entries and reused
+         * for every search without clearing or reallocating.
+         *
+         * Memory: 8 bytes per node (position + generation stamp)
+         */
+        typedef struct HeapIndex
+        {
+            dmArray<uint32_t> m_Positions;   // Heap slot of each node ID (INVALID_ID once popped)
+            dmArray<uint32_t> m_Generations; // Generation stamp of each node ID entry
+            uint32_t          m_Generation;  // Current generation (entries with other stamps are stale)
+        } HeapIndex;
+
         // Global state for version tracking
         extern GraphVersion         m_CurrentVersion; // Current graph version
         extern dmArray<NodeVersion> m_NodeVersions;   // Per-node version tracking
@@ -257,7 +305,7 @@ namespace pathfinder
          * @param new_fscore New priority value (must be lower)
          *
          * Note: Current implementation requires linear search. For O(log n) operation,
-         * maintain a separate index->position map.
+         * use the indexed mode (HeapIndex + decrease_key_indexed()).
          */
         static inline void decrease_key(HeapBlock* heap, uint32_t index, float new_fscore)
         {
@@ -393,6 +441,251 @@ namespace pathfinder
             return result;
         }
 
+        /*******************************************/
+        // INDEXED HEAP MODE
+        /*******************************************/
+
+        /**
+         * @brief Allocate a heap position map
+         * @param index Position map to initialize
+         * @param max_nodes Number of node IDs the map must cover (graph max_nodes)
+         *
+         * This is the only allocation of the indexed mode. Call once at startup,
+         * then index_clear() before each search.
+         *
+         * Time complexity: O(max_nodes)
+         */
+        static inline void index_init(HeapIndex* index, const uint32_t max_nodes)
+        {
+            index->m_Positions.SetCapacity(max_nodes);
+            index->m_Positions.SetSize(max_nodes);
+            index->m_Generations.SetCapacity(max_nodes);
+            index->m_Generations.SetSize(max_nodes);
+            if (max_nodes > 0)
+            {
+                memset(index->m_Generations.Begin(), 0, max_nodes * sizeof(uint32_t));
+            }
+            index->m_Generation = 1;
+        }
+
+        /**
+         * @brief Release the memory of a heap position map
+         * @param index Position map to release
+         */
+        static inline void index_shutdown(HeapIndex* index)
+        {
+            index->m_Positions.SetCapacity(0);
+            index->m_Generations.SetCapacity(0);
+            index->m_Generation = 0;
+        }
+
+        /**
+         * @brief Invalidate every position in the map
+         * @param index Position map to clear
+         *
+         * Bumps the generation so all existing entries become stale. The stamp array
+         * is only rewritten when the 32-bit generation counter wraps around.
+         *
+         * Time complexity: O(1) (amortized)
+         */
+        static inline void index_clear(HeapIndex* index)
+        {
+            index->m_Generation++;
+            if (index->m_Generation == 0)
+            {
+                if (index->m_Generations.Size() > 0)
+                {
+                    memset(index->m_Generations.Begin(), 0, index->m_Generations.Size() * sizeof(uint32_t));
+                }
+                index->m_Generation = 1;
+            }
+        }
+
+        /**
+         * @brief Check whether a node is currently in the heap (open list)
+         * @param index Position map of the heap
+         * @param node_index Node ID to check
+         * @return true if the node has been pushed and not yet popped
+         *
+         * Time complexity: O(1)
+         */
+        static inline bool contains(const HeapIndex* index, const uint32_t node_index)
+        {
+            return node_index < index->m_Generations.Size() &&
+                   index->m_Generations[node_index] == index->m_Generation &&
+                   index->m_Positions[node_index] != INVALID_ID;
+        }
+
+        /**
+         * @brief Swap two heap elements and update their positions in the map
+         *
+         * Time complexity: O(1)
+         */
+        static inline void swap_indexed(HeapBlock* heap, HeapIndex* index, const uint32_t index_a, const uint32_t index_b)
+        {
+            swap(heap, index_a, index_b);
+            index->m_Positions[heap->m_Nodes[index_a].m_Index] = index_a;
+            index->m_Positions[heap->m_Nodes[index_b].m_Index] = index_b;
+        }
+
+        /**
+         * @brief Bubble an element up until the min-heap property holds
+         *
+         * Time complexity: O(log n)
+         */
+        static inline void sift_up_indexed(HeapBlock* heap, HeapIndex* index, uint32_t current)
+        {
+            while (current > 0)
+            {
+                uint32_t parent = (current - 1) / 2;
+                if (heap->m_Nodes[parent].m_FScore <= heap->m_Nodes[current].m_FScore)
+                    break;
+                swap_indexed(heap, index, current, parent);
+                current = parent;
+            }
+        }
+
+        /**
+         * @brief Bubble an element down until the min-heap property holds
+         *
+         * Time complexity: O(log n)
+         */
+        static inline void sift_down_indexed(HeapBlock* heap, HeapIndex* index, uint32_t current)
+        {
+            while (true)
+            {
+                uint32_t left_child = 2 * current + 1;
+                uint32_t right_child = 2 * current + 2;
+                uint32_t smallest = current;
+
+                if (left_child < heap->m_Size &&
+                    heap->m_Nodes[left_child].m_FScore < heap->m_Nodes[smallest].m_FScore)
+                    smallest = left_child;
+
+                if (right_child < heap->m_Size &&
+                    heap->m_Nodes[right_child].m_FScore < heap->m_Nodes[smallest].m_FScore)
+                    smallest = right_child;
+
+                if (smallest == current)
+                    break;
+
+                swap_indexed(heap, index, current, smallest);
+                current = smallest;
+            }
+        }
+
+        /**
+         * @brief Insert an element and record its position
+         * @param heap Heap block to insert into
+         * @param index Position map of the heap
+         * @param node_index Node ID to insert (must be < max_nodes given to index_init)
+         * @param f_score Priority value (f-score in A* pathfinding)
+         * @return SUCCESS, or ERROR_HEAP_FULL if the block is full
+         *
+         * The node must not already be in the heap; use push_or_decrease_key()
+         * when that is not known.
+         *
+         * Time complexity: O(log n)
+         */
+        static inline PathStatus push_indexed(HeapBlock* heap, HeapIndex* index, const uint32_t node_index, const float f_score)
+        {
+            if (heap->m_Size >= heap->m_Capacity)
+            {
+                return ERROR_HEAP_FULL;
+            }
+
+            uint32_t current = heap->m_Size++;
+            heap->m_Nodes[current] = HeapNode { node_index, f_score };
+            index->m_Positions[node_index] = current;
+            index->m_Generations[node_index] = index->m_Generation;
+
+            sift_up_indexed(heap, index, current);
+            return SUCCESS;
+        }
+
+        /**
+         * @brief Extract the minimum element and clear its position
+         * @param heap Heap block to extract from
+         * @param index Position map of the heap
+         * @return Node ID with the lowest f-score, or INVALID_ID if heap is empty
+         *
+         * After the call contains() returns false for the extracted node.
+         *
+         * Time complexity: O(log n)
+         */
+        static inline uint32_t pop_indexed(HeapBlock* heap, HeapIndex* index)
+        {
+            if (heap->m_Size == 0)
+            {
+                return INVALID_ID;
+            }
+
+            uint32_t result = heap->m_Nodes[0].m_Index;
+            index->m_Positions[result] = INVALID_ID;
+            heap->m_Size--;
+
+            if (heap->m_Size > 0)
+            {
+                heap->m_Nodes[0] = heap->m_Nodes[heap->m_Size];
+                index->m_Positions[heap->m_Nodes[0].m_Index] = 0;
+                sift_down_indexed(heap, index, 0);
+            }
+
+            return result;
+        }
+
+        /**
+         * @brief Update priority of an element through the position map
+         * @param heap Heap block
+         * @param index Position map of the heap
+         * @param node_index Node ID to update
+         * @param new_fscore New priority value (must not be higher than the current one)
+         * @return true if the node was in the heap and got updated, false otherwise
+         *
+         * Time complexity: O(log n)
+         */
+        static inline bool decrease_key_indexed(HeapBlock* heap, HeapIndex* index, const uint32_t node_index, const float new_fscore)
+        {
+            if (!contains(index, node_index))
+            {
+                return false;
+            }
+
+            uint32_t position = index->m_Positions[node_index];
+            heap->m_Nodes[position].m_FScore = new_fscore;
+            sift_up_indexed(heap, index, position);
+            return true;
+        }
+
+        /**
+         * @brief Insert a node, or lower its priority if it is already in the heap
+         * @param heap Heap block
+         * @param index Position map of the heap
+         * @param node_index Node ID to insert or update
+         * @param f_score New priority value
+         * @return SUCCESS, or ERROR_HEAP_FULL if a new insertion did not fit
+         *
+         * This is the A* relaxation step: no duplicate entries are created for a
+         * node, which keeps the open list (and pool_block_size demand) smaller than
+         * the push-duplicates approach.
+         *
+         * Time complexity: O(log n)
+         */
+        static inline PathStatus push_or_decrease_key(HeapBlock* heap, HeapIndex* index, const uint32_t node_index, const float f_score)
+        {
+            if (contains(index, node_index))
+            {
+                uint32_t position = index->m_Positions[node_index];
+                if (f_score < heap->m_Nodes[position].m_FScore)
+                {
+                    heap->m_Nodes[position].m_FScore = f_score;
+                    sift_up_indexed(heap, index, position);
+                }
+                return SUCCESS;
+            }
+            return push_indexed(heap, index, node_index, f_score);
+        }
+
     } // namespace heap
 } // namespace pathfinder
 #endif
\ No newline at end of file
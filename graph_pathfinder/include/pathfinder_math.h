@@ -696,6 +696,120 @@ namespace pathfinder
             return result;
         }
 
+        /**
+         * @brief Build a cumulative arc-length table for a polyline
+         * @param points Polyline points
+         * @param count Number of points
+         * @param lengths Output table, must hold count floats (lengths[i] = distance from points[0] to points[i])
+         * @return Total polyline length (0 for count < 2)
+         *
+         * Pairs with sample_at_distance() to move along a smoothed path at constant
+         * speed regardless of how unevenly the smoother spaced its samples.
+         * Build the table once per path and reuse it for every lookup.
+         *
+         * Time Complexity: O(n)
+         */
+        static inline float build_arc_length_table(const Vec2* points, const uint32_t count, float* lengths)
+        {
+            if (count == 0)
+            {
+                return 0.0f;
+            }
+
+            lengths[0] = 0.0f;
+            for (uint32_t i = 1; i < count; ++i)
+            {
+                lengths[i] = lengths[i - 1] + distance(points[i - 1], points[i]);
+            }
+            return lengths[count - 1];
+        }
+
+        /**
+         * @brief Sample a polyline at a given distance along it
+         * @param points Polyline points
+         * @param lengths Cumulative arc-length table from build_arc_length_table()
+         * @param count Number of points (must be > 0)
+         * @param dist Distance along the polyline, clamped to [0, total length]
+         * @param cursor Optional segment cursor (in/out), may be NULL
+         * @return Position at dist along the polyline
+         *
+         * With a cursor, lookups that move forward (agent movement) scan from the
+         * previous segment and are amortized O(1). Without one, or when dist moves
+         * backwards, the segment is found by binary search.
+         *
+         * Example:
+         * @code
+         * float    total = build_arc_length_table(path, count, lengths);
+         * uint32_t cursor = 0;
+         * for (float d = 0.0f; d < total; d += speed * dt) {
+         *     Vec2 pos = sample_at_distance(path, lengths, count, d, &cursor);
+         * }
+         * @endcode
+         *
+         * Time Complexity: O(1) amortized with cursor, O(log n) otherwise
+         */
+        static inline Vec2 sample_at_distance(const Vec2* points, const float* lengths, const uint32_t count, float dist, uint32_t* cursor)
+        {
+            if (count < 2 || dist <= 0.0f)
+            {
+                if (cursor)
+                {
+                    *cursor = 0;
+                }
+                return points[0];
+            }
+
+            if (dist >= lengths[count - 1])
+            {
+                if (cursor)
+                {
+                    *cursor = count - 2;
+                }
+                return points[count - 1];
+            }
+
+            // Find segment i with lengths[i] <= dist < lengths[i + 1]
+            uint32_t i;
+            if (cursor && *cursor < count - 1 && lengths[*cursor] <= dist)
+            {
+                i = *cursor;
+                while (lengths[i + 1] <= dist)
+                {
+                    ++i;
+                }
+            }
+            else
+            {
+                uint32_t lo = 0;
+                uint32_t hi = count - 1;
+                while (hi - lo > 1)
+                {
+                    uint32_t mid = lo + (hi - lo) / 2;
+                    if (lengths[mid] <= dist)
+                    {
+                        lo = mid;
+                    }
+                    else
+                    {
+                        hi = mid;
+                    }
+                }
+                i = lo;
+            }
+
+            if (cursor)
+            {
+                *cursor = i;
+            }
+
+            float segment = lengths[i + 1] - lengths[i];
+            if (segment <= 0.0f)
+            {
+                return points[i];
+            }
+            return lerp(points[i], points[i + 1], (dist - lengths[i]) / segment);
+        }
+
     } // namespace math
 } // namespace pathfinder
 #endif
\ No newline at end of file
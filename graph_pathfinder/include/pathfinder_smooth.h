@@ -77,6 +77,30 @@ namespace pathfinder
          */
         uint32_t calculate_smoothed_path_capacity(dmArray<uint32_t>& path, uint32_t samples_per_segment);
 
+        /**
+         * @brief Calculate required capacity for smoothing a waypoint array
+         * @param waypoint_count Number of input waypoints
+         * @param samples_per_segment Number of samples per segment
+         * @return Conservative capacity estimate (number of Vec2 elements)
+         *
+         * Same estimate as calculate_smoothed_path_capacity(), for the *_waypoints
+         * variants. Projected paths carry up to 4 waypoints more than their node path
+         * (start, entry, exit, target), so sizing them from the node path under-allocates
+         * and makes safe_push() grow the output in the middle of the sampling loop.
+         *
+         * Time Complexity: O(1)
+         */
+        static inline uint32_t calculate_smoothed_waypoint_capacity(const uint32_t waypoint_count, const uint32_t samples_per_segment)
+        {
+            if (waypoint_count <= 1)
+            {
+                return 2;
+            }
+
+            uint32_t base = (waypoint_count - 1) * samples_per_segment + waypoint_count;
+            return base + base / 5 + 2; // 20% safety margin
+        }
+
         /*******************************************/
         // CATMULL-ROM SPLINE SMOOTHING
         /*******************************************/
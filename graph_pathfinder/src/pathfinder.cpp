@@ -86,8 +86,24 @@ static inline void push_path_node_table(lua_State* L, const pathfinder::Vec2& po
 }
 
 // Helper function to create a Lua table array from smoothed path positions
-static inline void push_smoothed_path_table(lua_State* L, const dmArray<pathfinder::Vec2>& smoothed_path)
+// flat: { x, y, x, y, ... } instead of { {x, y}, ... }
+static inline void push_smoothed_path_table(lua_State* L, const dmArray<pathfinder::Vec2>& smoothed_path, bool flat = false)
 {
+    if (flat)
+    {
+        lua_createtable(L, smoothed_path.Size() * 2, 0);
+        int newTable = lua_gettop(L);
+        for (uint32_t i = 0; i < smoothed_path.Size(); ++i)
+        {
+            lua_pushnumber(L, smoothed_path[i].x);
+            lua_rawseti(L, newTable, i * 2 + 1);
+
+            lua_pushnumber(L, smoothed_path[i].y);
+            lua_rawseti(L, newTable, i * 2 + 2);
+        }
+        return;
+    }
+
     lua_createtable(L, smoothed_path.Size(), 0);
     int newTable = lua_gettop(L);
     for (int i = 0; i < smoothed_path.Size(); ++i)
@@ -97,6 +113,40 @@ static inline void push_smoothed_path_table(lua_State* L, const dmArray<pathfind
     }
 }
 
+// Helper function to create a Lua table array from path node IDs
+// flat: { x, y, id, x, y, id, ... } instead of { {x, y, id}, ... }
+static inline void push_node_path_table(lua_State* L, const dmArray<uint32_t>& path, uint32_t path_length, bool flat = false)
+{
+    if (flat)
+    {
+        lua_createtable(L, path_length * 3, 0);
+        int newTable = lua_gettop(L);
+        for (uint32_t i = 0; i < path_length; ++i)
+        {
+            pathfinder::Vec2 node_position = pathfinder::path::get_node_position(path[i]);
+
+            lua_pushnumber(L, node_position.x);
+            lua_rawseti(L, newTable, i * 3 + 1);
+
+            lua_pushnumber(L, node_position.y);
+            lua_rawseti(L, newTable, i * 3 + 2);
+
+            lua_pushinteger(L, path[i]);
+            lua_rawseti(L, newTable, i * 3 + 3);
+        }
+        return;
+    }
+
+    lua_createtable(L, path_length, 0);
+    int newTable = lua_gettop(L);
+    for (uint32_t i = 0; i < path_length; ++i)
+    {
+        pathfinder::Vec2 node_position = pathfinder::path::get_node_position(path[i]);
+        push_path_node_table(L, node_position, path[i], true);
+        lua_rawseti(L, newTable, i + 1);
+    }
+}
+
 static int pathfinder_init(lua_State* L)
 {
     DM_LUA_STACK_CHECK(L, 0);
@@ -123,6 +173,10 @@ static int pathfinder_init(lua_State* L)
         pool_block_size = 32;
     }
     pathfinder::path::init(max_nodes, max_edges_per_node, pool_block_size, max_cache_path_length);
+    pathfinder::extension::set_node_capacity(max_nodes);
+    pathfinder::extension::bump_topology_version();
+    pathfinder::extension::clear_smoothed_path_cache();
+    pathfinder::extension::reset_query_stats();
 
     if (max_gameobject_nodes > 0)
     {
@@ -168,6 +222,8 @@ static int pathfinder_add_nodes(lua_State* L)
         lua_pop(L, 1); // pop inner table
     }
 
+    pathfinder::extension::bump_topology_version();
+
     // OUT ->>
     lua_createtable(L, node_ids.Size(), 0);
     for (int i = 0; i < node_ids.Size(); ++i)
@@ -192,16 +248,20 @@ static int pathfinder_add_gameobject_node(lua_State* L)
 
     pathfinder::PathStatus  status;
     uint32_t                node_id = pathfinder::path::add_node(pos, &status);
-    pathfinder::extension::add_gameobject_node(node_id, gameobject_instance, gameobject_position, use_world_position);
-
-    // OUT ->>
-    lua_pushinteger(L, node_id);
 
-    if (status != pathfinder::SUCCESS)
+    if (status == pathfinder::SUCCESS)
+    {
+        pathfinder::extension::add_gameobject_node(node_id, gameobject_instance, gameobject_position, use_world_position);
+        pathfinder::extension::bump_topology_version();
+    }
+    else
     {
         dmLogError("Failed. %s  (status: %d)", path_status_to_string(status), status);
     }
 
+    // OUT ->>
+    lua_pushinteger(L, node_id);
+
     return 1;
 }
 
@@ -242,7 +302,6 @@ static int pathfinder_add_gameobject_nodes(lua_State* L)
         pathfinder::Vec2 pos(gameobject_position.getX(), gameobject_position.getY());
 
         uint32_t         node_id = pathfinder::path::add_node(pos, &status);
-        pathfinder::extension::add_gameobject_node(node_id, go_instance, gameobject_position, use_world_position);
 
         if (status != pathfinder::SUCCESS)
         {
@@ -250,12 +309,15 @@ static int pathfinder_add_gameobject_nodes(lua_State* L)
         }
         else
         {
+            pathfinder::extension::add_gameobject_node(node_id, go_instance, gameobject_position, use_world_position);
             node_ids.Push(node_id);
         }
 
         lua_pop(L, 1); // pop nodes[i]
     }
 
+    pathfinder::extension::bump_topology_version();
+
     // OUT ->>
     lua_createtable(L, node_ids.Size(), 0);
     for (int i = 0; i < node_ids.Size(); ++i)
@@ -295,6 +357,7 @@ static int pathfinder_add_node(lua_State* L)
     pathfinder::PathStatus status;
 
     uint32_t               node_id = pathfinder::path::add_node(pos, &status);
+    pathfinder::extension::bump_topology_version();
 
     lua_pushinteger(L, node_id);
 
@@ -368,6 +431,8 @@ static int pathfinder_add_edges(lua_State* L)
         lua_pop(L, 1); // pop inner table
     }
 
+    pathfinder::extension::bump_topology_version();
+
     return 0;
 }
 
@@ -396,6 +461,7 @@ static int pathfinder_add_edge(lua_State* L)
 
     pathfinder::PathStatus status;
     pathfinder::path::add_edge(from_node_id, to_node_id, cost, bidirectional, &status);
+    pathfinder::extension::bump_topology_version();
 
     if (status != pathfinder::SUCCESS)
     {
@@ -405,37 +471,100 @@ static int pathfinder_add_edge(lua_State* L)
     return 0;
 }
 
+static int pathfinder_save_graph(lua_State* L)
+{
+    DM_LUA_STACK_CHECK(L, 1);
+
+    // IN  <<-
+    luaL_checktype(L, 1, LUA_TTABLE);
+
+    int               node_count = (int)lua_objlen(L, 1);
+    dmArray<uint32_t> node_ids;
+    node_ids.SetCapacity(node_count);
+
+    for (int i = 1; i <= node_count; ++i)
+    {
+        lua_rawgeti(L, 1, i);
+        node_ids.Push(luaL_checkint(L, -1));
+        lua_pop(L, 1);
+    }
+
+    dmArray<uint8_t> snapshot;
+    pathfinder::extension::save_graph(node_ids, snapshot);
+
+    // OUT ->>
+    lua_pushlstring(L, (const char*)snapshot.Begin(), snapshot.Size());
+
+    return 1;
+}
+
+static int pathfinder_load_graph(lua_State* L)
+{
+    DM_LUA_STACK_CHECK(L, 2);
+
+    // IN  <<-
+    size_t      size = 0;
+    const char* data = luaL_checklstring(L, 1, &size);
+
+    dmArray<uint32_t> node_ids;
+    uint32_t          failed_edges = 0;
+    bool              loaded = pathfinder::extension::load_graph((const uint8_t*)data, (uint32_t)size, node_ids, failed_edges);
+
+    // OUT ->>
+    if (!loaded)
+    {
+        lua_pushnil(L);
+        lua_pushinteger(L, 0);
+        return 2;
+    }
+
+    lua_createtable(L, node_ids.Size(), 0);
+    for (uint32_t i = 0; i < node_ids.Size(); ++i)
+    {
+        lua_pushinteger(L, node_ids[i]);
+        lua_rawseti(L, -2, i + 1);
+    }
+    lua_pushinteger(L, failed_edges);
+
+    return 2;
+}
+
 static int pathfinder_find_node_to_node_path(lua_State* L)
 {
     DM_LUA_STACK_CHECK(L, 4);
+    DM_PROFILE("Pathfinder.FindNodeToNode");
 
     // IN <-
     uint32_t start_node_id = luaL_checkint(L, 1);
     uint32_t goal_node_id = luaL_checkint(L, 2);
     uint32_t max_path = luaL_checkint(L, 3);
     uint32_t smooth_id = (uint32_t)luaL_optinteger(L, 4, 0);
+    bool     flat = lua_toboolean(L, 5);
 
     // OUT ->
-    dmArray<uint32_t>      path;
+    dmArray<uint32_t>&     path = pathfinder::extension::get_arena_path();
     pathfinder::PathStatus status;
-    uint32_t               path_length = pathfinder::path::find_path(start_node_id, goal_node_id, &path, max_path, &status);
+    uint64_t               search_start = dmTime::GetMonotonicTime();
+    uint32_t               path_length = pathfinder::extension::find_node_path(start_node_id, goal_node_id, path, max_path, &status);
+    pathfinder::extension::record_query(status, path_length, dmTime::GetMonotonicTime() - search_start);
 
     // Smoothing
     if (smooth_id > 0)
     {
-        dmArray<pathfinder::Vec2> smoothed_path;
-        uint32_t                  samples_per_segment = pathfinder::extension::get_smooth_sample_segment(smooth_id);
-        uint32_t                  capacity = pathfinder::smooth::calculate_smoothed_path_capacity(path, samples_per_segment);
-        smoothed_path.SetCapacity(capacity);
+        uint32_t                   samples_per_segment = pathfinder::extension::get_smooth_sample_segment(smooth_id);
+        uint32_t                   capacity = pathfinder::smooth::calculate_smoothed_path_capacity(path, samples_per_segment);
+        dmArray<pathfinder::Vec2>& smoothed_path = pathfinder::extension::get_arena_smoothed_path(capacity);
 
+        uint64_t smooth_start = dmTime::GetMonotonicTime();
         pathfinder::extension::smooth_path(smooth_id, path, smoothed_path);
+        pathfinder::extension::record_smoothing(dmTime::GetMonotonicTime() - smooth_start);
 
         lua_pushinteger(L, smoothed_path.Size());
         lua_pushinteger(L, status);
         lua_pushstring(L, path_status_to_string(status));
 
         // Result table
-        push_smoothed_path_table(L, smoothed_path);
+        push_smoothed_path_table(L, smoothed_path, flat);
     }
     else
     {
@@ -444,22 +573,136 @@ static int pathfinder_find_node_to_node_path(lua_State* L)
         lua_pushstring(L, path_status_to_string(status));
 
         // Result table
-        lua_createtable(L, path_length, 0);
-        int newTable = lua_gettop(L);
-        for (int i = 0; i < path_length; ++i)
-        {
-            pathfinder::Vec2 node_position = pathfinder::path::get_node_position(path[i]);
-            push_path_node_table(L, node_position, path[i], true);
-            lua_rawseti(L, newTable, i + 1);
-        }
+        push_node_path_table(L, path, path_length, flat);
+    }
+
+    return 4;
+}
+
+static int pathfinder_find_flow_field_path(lua_State* L)
+{
+    DM_LUA_STACK_CHECK(L, 4);
+    DM_PROFILE("Pathfinder.FindFlowFieldPath");
+
+    // IN <-
+    uint32_t start_node_id = luaL_checkint(L, 1);
+    uint32_t goal_node_id = luaL_checkint(L, 2);
+    uint32_t max_path = luaL_checkint(L, 3);
+    uint32_t smooth_id = (uint32_t)luaL_optinteger(L, 4, 0);
+    bool     flat = lua_toboolean(L, 5);
+
+    // OUT ->
+    dmArray<uint32_t>&     path = pathfinder::extension::get_arena_path();
+    pathfinder::PathStatus status;
+    uint64_t               search_start = dmTime::GetMonotonicTime();
+    uint32_t               path_length = pathfinder::extension::find_flow_field_path(start_node_id, goal_node_id, path, max_path, &status);
+    pathfinder::extension::record_query(status, path_length, dmTime::GetMonotonicTime() - search_start);
+
+    // Smoothing
+    if (smooth_id > 0)
+    {
+        uint32_t                   samples_per_segment = pathfinder::extension::get_smooth_sample_segment(smooth_id);
+        uint32_t                   capacity = pathfinder::smooth::calculate_smoothed_path_capacity(path, samples_per_segment);
+        dmArray<pathfinder::Vec2>& smoothed_path = pathfinder::extension::get_arena_smoothed_path(capacity);
+
+        uint64_t smooth_start = dmTime::GetMonotonicTime();
+        pathfinder::extension::smooth_path(smooth_id, path, smoothed_path);
+        pathfinder::extension::record_smoothing(dmTime::GetMonotonicTime() - smooth_start);
+
+        lua_pushinteger(L, smoothed_path.Size());
+        lua_pushinteger(L, status);
+        lua_pushstring(L, path_status_to_string(status));
+
+        // Result table
+        push_smoothed_path_table(L, smoothed_path, flat);
+    }
+    else
+    {
+        lua_pushinteger(L, path_length);
+        lua_pushinteger(L, status);
+        lua_pushstring(L, path_status_to_string(status));
+
+        // Result table
+        push_node_path_table(L, path, path_length, flat);
     }
 
     return 4;
 }
 
+static int pathfinder_set_flow_field_capacity(lua_State* L)
+{
+    DM_LUA_STACK_CHECK(L, 0);
+
+    uint32_t capacity = luaL_checkint(L, 1);
+    pathfinder::extension::set_flow_field_capacity(capacity);
+
+    return 0;
+}
+
+static int pathfinder_find_bidirectional_path(lua_State* L)
+{
+    DM_LUA_STACK_CHECK(L, 4);
+    DM_PROFILE("Pathfinder.FindBidirectionalPath");
+
+    // IN <-
+    uint32_t start_node_id = luaL_checkint(L, 1);
+    uint32_t goal_node_id = luaL_checkint(L, 2);
+    uint32_t max_path = luaL_checkint(L, 3);
+    uint32_t smooth_id = (uint32_t)luaL_optinteger(L, 4, 0);
+    bool     flat = lua_toboolean(L, 5);
+
+    // OUT ->
+    dmArray<uint32_t>&     path = pathfinder::extension::get_arena_path();
+    pathfinder::PathStatus status;
+    uint64_t               search_start = dmTime::GetMonotonicTime();
+    uint32_t               path_length = pathfinder::extension::find_bidirectional_path(start_node_id, goal_node_id, path, max_path, &status);
+    pathfinder::extension::record_query(status, path_length, dmTime::GetMonotonicTime() - search_start);
+
+    // Smoothing
+    if (smooth_id > 0)
+    {
+        uint32_t                   samples_per_segment = pathfinder::extension::get_smooth_sample_segment(smooth_id);
+        uint32_t                   capacity = pathfinder::smooth::calculate_smoothed_path_capacity(path, samples_per_segment);
+        dmArray<pathfinder::Vec2>& smoothed_path = pathfinder::extension::get_arena_smoothed_path(capacity);
+
+        uint64_t smooth_start = dmTime::GetMonotonicTime();
+        pathfinder::extension::smooth_path(smooth_id, path, smoothed_path);
+        pathfinder::extension::record_smoothing(dmTime::GetMonotonicTime() - smooth_start);
+
+        lua_pushinteger(L, smoothed_path.Size());
+        lua_pushinteger(L, status);
+        lua_pushstring(L, path_status_to_string(status));
+
+        // Result table
+        push_smoothed_path_table(L, smoothed_path, flat);
+    }
+    else
+    {
+        lua_pushinteger(L, path_length);
+        lua_pushinteger(L, status);
+        lua_pushstring(L, path_status_to_string(status));
+
+        // Result table
+        push_node_path_table(L, path, path_length, flat);
+    }
+
+    return 4;
+}
+
+static int pathfinder_set_bidirectional_threshold(lua_State* L)
+{
+    DM_LUA_STACK_CHECK(L, 0);
+
+    float distance = luaL_checknumber(L, 1);
+    pathfinder::extension::set_bidirectional_threshold(distance);
+
+    return 0;
+}
+
 static int pathfinder_find_projected_to_node_path(lua_State* L)
 {
     DM_LUA_STACK_CHECK(L, 5);
+    DM_PROFILE("Pathfinder.FindProjectedToNode");
 
     // IN <-
     float            x = luaL_checknumber(L, 1);
@@ -469,18 +712,20 @@ static int pathfinder_find_projected_to_node_path(lua_State* L)
     uint32_t         goal_node_id = luaL_checkint(L, 3);
     uint32_t         max_path = luaL_checkint(L, 4);
     uint32_t         smooth_id = (uint32_t)luaL_optinteger(L, 5, 0);
+    bool             flat = lua_toboolean(L, 6);
 
     // OUT ->
-    dmArray<uint32_t>      path;
+    dmArray<uint32_t>&     path = pathfinder::extension::get_arena_path();
     pathfinder::PathStatus status;
     pathfinder::Vec2       entry_point;
+    uint64_t               search_start = dmTime::GetMonotonicTime();
     uint32_t               path_length = pathfinder::path::find_path_projected(pos, goal_node_id, &path, max_path, &entry_point, &status);
+    pathfinder::extension::record_query(status, path_length, dmTime::GetMonotonicTime() - search_start);
 
     // Smoothing
     if (smooth_id > 0)
     {
-        dmArray<pathfinder::Vec2> waypoints;
-        waypoints.SetCapacity(path_length + 2);
+        dmArray<pathfinder::Vec2>& waypoints = pathfinder::extension::get_arena_waypoints(path_length + 2);
         waypoints.Push(pos);         // Start position
         waypoints.Push(entry_point); // Entry point on graph
 
@@ -490,12 +735,13 @@ static int pathfinder_find_projected_to_node_path(lua_State* L)
             waypoints.Push(pathfinder::path::get_node_position(path[i]));
         }
 
-        dmArray<pathfinder::Vec2> smoothed_path;
-        uint32_t                  samples_per_segment = pathfinder::extension::get_smooth_sample_segment(smooth_id);
-        uint32_t                  capacity = pathfinder::smooth::calculate_smoothed_path_capacity(path, samples_per_segment);
-        smoothed_path.SetCapacity(capacity);
+        uint32_t                   samples_per_segment = pathfinder::extension::get_smooth_sample_segment(smooth_id);
+        uint32_t                   capacity = pathfinder::smooth::calculate_smoothed_waypoint_capacity(waypoints.Size(), samples_per_segment);
+        dmArray<pathfinder::Vec2>& smoothed_path = pathfinder::extension::get_arena_smoothed_path(capacity);
 
+        uint64_t smooth_start = dmTime::GetMonotonicTime();
         pathfinder::extension::smooth_path_waypoint(smooth_id, waypoints, smoothed_path);
+        pathfinder::extension::record_smoothing(dmTime::GetMonotonicTime() - smooth_start);
 
         lua_pushinteger(L, smoothed_path.Size());
         lua_pushinteger(L, status);
@@ -503,7 +749,7 @@ static int pathfinder_find_projected_to_node_path(lua_State* L)
         dmScript::PushVector3(L, dmVMath::Vector3(entry_point.x, entry_point.y, 0));
 
         // Result table
-        push_smoothed_path_table(L, smoothed_path);
+        push_smoothed_path_table(L, smoothed_path, flat);
     }
     else
     {
@@ -513,14 +759,7 @@ static int pathfinder_find_projected_to_node_path(lua_State* L)
         dmScript::PushVector3(L, dmVMath::Vector3(entry_point.x, entry_point.y, 0));
 
         // Result table
-        lua_createtable(L, path_length, 0);
-        int newTable = lua_gettop(L);
-        for (int i = 0; i < path_length; i++)
-        {
-            pathfinder::Vec2 node_position = pathfinder::path::get_node_position(path[i]);
-            push_path_node_table(L, node_position, path[i], true);
-            lua_rawseti(L, newTable, i + 1);
-        }
+        push_node_path_table(L, path, path_length, flat);
     }
     return 5;
 }
@@ -528,6 +767,7 @@ static int pathfinder_find_projected_to_node_path(lua_State* L)
 static int pathfinder_find_node_to_projected_path(lua_State* L)
 {
     DM_LUA_STACK_CHECK(L, 5);
+    DM_PROFILE("Pathfinder.FindNodeToProjected");
 
     // IN <-
     uint32_t         start_node_id = luaL_checkint(L, 1);
@@ -537,18 +777,20 @@ static int pathfinder_find_node_to_projected_path(lua_State* L)
 
     uint32_t         max_path = luaL_checkint(L, 4);
     uint32_t         smooth_id = (uint32_t)luaL_optinteger(L, 5, 0);
+    bool             flat = lua_toboolean(L, 6);
 
     // OUT ->
-    dmArray<uint32_t>      path;
+    dmArray<uint32_t>&     path = pathfinder::extension::get_arena_path();
     pathfinder::PathStatus status;
     pathfinder::Vec2       exit_point;
+    uint64_t               search_start = dmTime::GetMonotonicTime();
     uint32_t               path_length = pathfinder::path::find_path_projected_with_exit(pathfinder::Vec2(0, 0), target_position, start_node_id, &path, max_path, NULL, &exit_point, &status);
+    pathfinder::extension::record_query(status, path_length, dmTime::GetMonotonicTime() - search_start);
 
     // Smoothing
     if (smooth_id > 0)
     {
-        dmArray<pathfinder::Vec2> waypoints;
-        waypoints.SetCapacity(path_length + 2);
+        dmArray<pathfinder::Vec2>& waypoints = pathfinder::extension::get_arena_waypoints(path_length + 2);
 
         // Add all path nodes
         for (uint32_t i = 0; i < path_length; i++)
@@ -560,12 +802,13 @@ static int pathfinder_find_node_to_projected_path(lua_State* L)
         waypoints.Push(exit_point);      // Exit point on graph
         waypoints.Push(target_position); // Target position
 
-        dmArray<pathfinder::Vec2> smoothed_path;
-        uint32_t                  samples_per_segment = pathfinder::extension::get_smooth_sample_segment(smooth_id);
-        uint32_t                  capacity = pathfinder::smooth::calculate_smoothed_path_capacity(path, samples_per_segment);
-        smoothed_path.SetCapacity(capacity);
+        uint32_t                   samples_per_segment = pathfinder::extension::get_smooth_sample_segment(smooth_id);
+        uint32_t                   capacity = pathfinder::smooth::calculate_smoothed_waypoint_capacity(waypoints.Size(), samples_per_segment);
+        dmArray<pathfinder::Vec2>& smoothed_path = pathfinder::extension::get_arena_smoothed_path(capacity);
 
+        uint64_t smooth_start = dmTime::GetMonotonicTime();
         pathfinder::extension::smooth_path_waypoint(smooth_id, waypoints, smoothed_path);
+        pathfinder::extension::record_smoothing(dmTime::GetMonotonicTime() - smooth_start);
 
         lua_pushinteger(L, smoothed_path.Size());
         lua_pushinteger(L, status);
@@ -573,7 +816,7 @@ static int pathfinder_find_node_to_projected_path(lua_State* L)
         dmScript::PushVector3(L, dmVMath::Vector3(exit_point.x, exit_point.y, 0));
 
         // Result table
-        push_smoothed_path_table(L, smoothed_path);
+        push_smoothed_path_table(L, smoothed_path, flat);
     }
     else
     {
@@ -583,14 +826,7 @@ static int pathfinder_find_node_to_projected_path(lua_State* L)
         dmScript::PushVector3(L, dmVMath::Vector3(exit_point.x, exit_point.y, 0));
 
         // Result table
-        lua_createtable(L, path_length, 0);
-        int newTable = lua_gettop(L);
-        for (int i = 0; i < path_length; i++)
-        {
-            pathfinder::Vec2 node_position = pathfinder::path::get_node_position(path[i]);
-            push_path_node_table(L, node_position, path[i], true);
-            lua_rawseti(L, newTable, i + 1);
-        }
+        push_node_path_table(L, path, path_length, flat);
     }
     return 5;
 }
@@ -598,6 +834,7 @@ static int pathfinder_find_node_to_projected_path(lua_State* L)
 static int pathfinder_find_projected_to_projected_path(lua_State* L)
 {
     DM_LUA_STACK_CHECK(L, 6);
+    DM_PROFILE("Pathfinder.FindProjectedToProjected");
 
     // IN <-
     float            start_x = luaL_checknumber(L, 1);
@@ -610,19 +847,21 @@ static int pathfinder_find_projected_to_projected_path(lua_State* L)
 
     uint32_t         max_path = luaL_checkint(L, 5);
     uint32_t         smooth_id = (uint32_t)luaL_optinteger(L, 6, 0);
+    bool             flat = lua_toboolean(L, 7);
 
     // OUT ->
-    dmArray<uint32_t>      path;
+    dmArray<uint32_t>&     path = pathfinder::extension::get_arena_path();
     pathfinder::PathStatus status;
     pathfinder::Vec2       entry_point;
     pathfinder::Vec2       exit_point;
+    uint64_t               search_start = dmTime::GetMonotonicTime();
     uint32_t               path_length = pathfinder::path::find_path_projected_with_exit(start_position, target_position, pathfinder::INVALID_ID, &path, max_path, &entry_point, &exit_point, &status);
+    pathfinder::extension::record_query(status, path_length, dmTime::GetMonotonicTime() - search_start);
 
     // Smoothing
     if (smooth_id > 0)
     {
-        dmArray<pathfinder::Vec2> waypoints;
-        waypoints.SetCapacity(path_length + 4);
+        dmArray<pathfinder::Vec2>& waypoints = pathfinder::extension::get_arena_waypoints(path_length + 4);
 
         // Enter
         waypoints.Push(start_position); // Start position
@@ -638,12 +877,13 @@ static int pathfinder_find_projected_to_projected_path(lua_State* L)
         waypoints.Push(exit_point);      // Exit point on graph
         waypoints.Push(target_position); // Target position
 
-        dmArray<pathfinder::Vec2> smoothed_path;
-        uint32_t                  samples_per_segment = pathfinder::extension::get_smooth_sample_segment(smooth_id);
-        uint32_t                  capacity = pathfinder::smooth::calculate_smoothed_path_capacity(path, samples_per_segment);
-        smoothed_path.SetCapacity(capacity);
+        uint32_t                   samples_per_segment = pathfinder::extension::get_smooth_sample_segment(smooth_id);
+        uint32_t                   capacity = pathfinder::smooth::calculate_smoothed_waypoint_capacity(waypoints.Size(), samples_per_segment);
+        dmArray<pathfinder::Vec2>& smoothed_path = pathfinder::extension::get_arena_smoothed_path(capacity);
 
+        uint64_t smooth_start = dmTime::GetMonotonicTime();
         pathfinder::extension::smooth_path_waypoint(smooth_id, waypoints, smoothed_path);
+        pathfinder::extension::record_smoothing(dmTime::GetMonotonicTime() - smooth_start);
 
         lua_pushinteger(L, smoothed_path.Size());
         lua_pushinteger(L, status);
@@ -652,7 +892,7 @@ static int pathfinder_find_projected_to_projected_path(lua_State* L)
         dmScript::PushVector3(L, dmVMath::Vector3(exit_point.x, exit_point.y, 0));
 
         // Result table
-        push_smoothed_path_table(L, smoothed_path);
+        push_smoothed_path_table(L, smoothed_path, flat);
     }
     else
     {
@@ -663,22 +903,267 @@ static int pathfinder_find_projected_to_projected_path(lua_State* L)
         dmScript::PushVector3(L, dmVMath::Vector3(exit_point.x, exit_point.y, 0));
 
         // Result table
-        lua_createtable(L, path_length, 0);
+        push_node_path_table(L, path, path_length, flat);
+    }
+    return 6;
+}
+
+// Batch buffers, reused across find_paths_batch calls
+static dmArray<pathfinder::extension::PathRequest> m_BatchRequests;
+static dmArray<pathfinder::extension::PathResult>  m_BatchResults;
+static dmArray<pathfinder::Vec2>                   m_BatchPoints;
+
+static int pathfinder_find_paths_batch(lua_State* L)
+{
+    DM_LUA_STACK_CHECK(L, 2);
+
+    // IN <-
+    luaL_checktype(L, 1, LUA_TTABLE);
+
+    int request_count = (int)lua_objlen(L, 1);
+
+    m_BatchRequests.SetSize(0);
+    if (m_BatchRequests.Capacity() < (uint32_t)request_count)
+    {
+        m_BatchRequests.SetCapacity(request_count);
+    }
+
+    for (int i = 1; i <= request_count; ++i)
+    {
+        lua_rawgeti(L, 1, i); // push requests[i]
+
+        pathfinder::extension::PathRequest request;
+        request.m_StartNodeId = pathfinder::INVALID_ID;
+        request.m_GoalNodeId = pathfinder::INVALID_ID;
+        request.m_MaxPath = 0;
+        request.m_SmoothId = 0;
+
+        if (lua_istable(L, -1))
+        {
+            // { start_node_id, goal_node_id, max_path_length, [smooth_id] }
+            lua_rawgeti(L, -1, 1);
+            request.m_StartNodeId = luaL_checkint(L, -1);
+            lua_pop(L, 1);
+
+            lua_rawgeti(L, -1, 2);
+            request.m_GoalNodeId = luaL_checkint(L, -1);
+            lua_pop(L, 1);
+
+            lua_rawgeti(L, -1, 3);
+            request.m_MaxPath = luaL_checkint(L, -1);
+            lua_pop(L, 1);
+
+            lua_rawgeti(L, -1, 4);
+            request.m_SmoothId = (uint32_t)luaL_optinteger(L, -1, 0);
+            lua_pop(L, 1);
+        }
+
+        m_BatchRequests.Push(request);
+
+        lua_pop(L, 1); // pop requests[i]
+    }
+
+    pathfinder::extension::find_paths_batch(m_BatchRequests, m_BatchResults, m_BatchPoints);
+
+    // OUT ->
+    // results: flat { status, offset, length, status, offset, length, ... }
+    lua_createtable(L, m_BatchResults.Size() * 3, 0);
+    int resultsTable = lua_gettop(L);
+    for (uint32_t i = 0; i < m_BatchResults.Size(); ++i)
+    {
+        lua_pushinteger(L, m_BatchResults[i].m_Status);
+        lua_rawseti(L, resultsTable, i * 3 + 1);
+
+        // 1-based index of the first x coordinate in the points table
+        lua_pushinteger(L, m_BatchResults[i].m_Offset * 2 + 1);
+        lua_rawseti(L, resultsTable, i * 3 + 2);
+
+        lua_pushinteger(L, m_BatchResults[i].m_Length);
+        lua_rawseti(L, resultsTable, i * 3 + 3);
+    }
+
+    // points: flat { x, y, x, y, ... }
+    lua_createtable(L, m_BatchPoints.Size() * 2, 0);
+    int pointsTable = lua_gettop(L);
+    for (uint32_t i = 0; i < m_BatchPoints.Size(); ++i)
+    {
+        lua_pushnumber(L, m_BatchPoints[i].x);
+        lua_rawseti(L, pointsTable, i * 2 + 1);
+
+        lua_pushnumber(L, m_BatchPoints[i].y);
+        lua_rawseti(L, pointsTable, i * 2 + 2);
+    }
+
+    return 2;
+}
+
+// Path job callbacks, keyed by ticket
+static dmHashTable32<dmScript::LuaCallbackInfo*> m_PathJobCallbacks;
+
+static void destroy_path_job_callback_iterate(void* /*context*/, const uint32_t* /*ticket*/, dmScript::LuaCallbackInfo** callback)
+{
+    dmScript::DestroyCallback(*callback);
+}
+
+static void clear_path_job_callbacks()
+{
+    m_PathJobCallbacks.Iterate(destroy_path_job_callback_iterate, (void*)0x0);
+    m_PathJobCallbacks.Clear();
+    pathfinder::extension::clear_path_jobs();
+}
+
+static void invoke_path_job_callback(const pathfinder::extension::PathJobResult& result)
+{
+    dmScript::LuaCallbackInfo** callback_ptr = m_PathJobCallbacks.Get(result.m_Ticket);
+    if (callback_ptr == 0x0)
+    {
+        return;
+    }
+
+    dmScript::LuaCallbackInfo* callback = *callback_ptr;
+    m_PathJobCallbacks.Erase(result.m_Ticket);
+
+    if (!dmScript::IsCallbackValid(callback))
+    {
+        dmScript::DestroyCallback(callback);
+        return;
+    }
+
+    lua_State* L = dmScript::GetCallbackLuaContext(callback);
+    DM_LUA_STACK_CHECK(L, 0);
+
+    if (dmScript::SetupCallback(callback))
+    {
+        lua_pushinteger(L, result.m_Ticket);
+        lua_pushinteger(L, result.m_Length);
+        lua_pushinteger(L, result.m_Status);
+        lua_pushstring(L, path_status_to_string(result.m_Status));
+
+        // Result table
+        lua_createtable(L, result.m_Length, 0);
         int newTable = lua_gettop(L);
-        for (int i = 0; i < path_length; i++)
+        if (result.m_Smoothed)
         {
-            pathfinder::Vec2 node_position = pathfinder::path::get_node_position(path[i]);
-            push_path_node_table(L, node_position, path[i], true);
-            lua_rawseti(L, newTable, i + 1);
+            const dmArray<pathfinder::Vec2>& points = pathfinder::extension::get_path_job_points();
+            for (uint32_t i = 0; i < result.m_Length; ++i)
+            {
+                push_path_node_table(L, points[result.m_Offset + i]);
+                lua_rawseti(L, newTable, i + 1);
+            }
         }
+        else
+        {
+            const dmArray<uint32_t>& nodes = pathfinder::extension::get_path_job_nodes();
+            for (uint32_t i = 0; i < result.m_Length; ++i)
+            {
+                uint32_t         node_id = nodes[result.m_Offset + i];
+                pathfinder::Vec2 node_position = pathfinder::path::get_node_position(node_id);
+                push_path_node_table(L, node_position, node_id, true);
+                lua_rawseti(L, newTable, i + 1);
+            }
+        }
+
+        dmScript::PCall(L, 6, 0); // self + 5 arguments
+
+        dmScript::TeardownCallback(callback);
     }
-    return 6;
+
+    dmScript::DestroyCallback(callback);
+}
+
+static void dispatch_path_job_results()
+{
+    const dmArray<pathfinder::extension::PathJobResult>& results = pathfinder::extension::get_path_job_results();
+    for (uint32_t i = 0; i < results.Size(); ++i)
+    {
+        invoke_path_job_callback(results[i]);
+    }
+}
+
+static int pathfinder_request_path(lua_State* L)
+{
+    DM_LUA_STACK_CHECK(L, 1);
+
+    // IN <-
+    pathfinder::extension::PathRequest request;
+    request.m_StartNodeId = luaL_checkint(L, 1);
+    request.m_GoalNodeId = luaL_checkint(L, 2);
+    request.m_MaxPath = luaL_checkint(L, 3);
+    request.m_SmoothId = (uint32_t)luaL_optinteger(L, 4, 0);
+    luaL_checktype(L, 5, LUA_TFUNCTION);
+
+    if (m_PathJobCallbacks.Full())
+    {
+        uint32_t capacity = m_PathJobCallbacks.Capacity() + 64;
+        m_PathJobCallbacks.SetCapacity(capacity);
+    }
+
+    // OUT ->
+    uint32_t ticket = pathfinder::extension::submit_path_job(request);
+    if (ticket > 0)
+    {
+        m_PathJobCallbacks.Put(ticket, dmScript::CreateCallback(L, 5));
+    }
+
+    lua_pushinteger(L, ticket);
+    return 1;
+}
+
+static int pathfinder_cancel_path_request(lua_State* L)
+{
+    DM_LUA_STACK_CHECK(L, 1);
+
+    uint32_t ticket = luaL_checkint(L, 1);
+    bool     cancelled = pathfinder::extension::cancel_path_job(ticket);
+
+    dmScript::LuaCallbackInfo** callback_ptr = m_PathJobCallbacks.Get(ticket);
+    if (callback_ptr != 0x0)
+    {
+        dmScript::DestroyCallback(*callback_ptr);
+        m_PathJobCallbacks.Erase(ticket);
+    }
+
+    lua_pushboolean(L, cancelled);
+    return 1;
+}
+
+static int pathfinder_set_path_request_capacity(lua_State* L)
+{
+    DM_LUA_STACK_CHECK(L, 0);
+
+    uint32_t capacity = luaL_checkint(L, 1);
+    pathfinder::extension::set_path_job_capacity(capacity);
+
+    return 0;
+}
+
+static int pathfinder_set_path_request_budget(lua_State* L)
+{
+    DM_LUA_STACK_CHECK(L, 0);
+
+    uint32_t max_requests = (uint32_t)luaL_optinteger(L, 1, 0);
+    uint32_t max_time = (uint32_t)luaL_optinteger(L, 2, 0);
+    pathfinder::extension::set_path_job_budget(max_requests, max_time);
+
+    return 0;
+}
+
+static int pathfinder_get_pending_path_request_count(lua_State* L)
+{
+    DM_LUA_STACK_CHECK(L, 1);
+
+    lua_pushinteger(L, pathfinder::extension::get_pending_path_job_count());
+
+    return 1;
 }
 
 static int pathfinder_shutdown(lua_State* L)
 {
     DM_LUA_STACK_CHECK(L, 0);
 
+    clear_path_job_callbacks();
+    pathfinder::extension::clear_flow_fields();
+    pathfinder::extension::clear_smoothed_path_cache();
     pathfinder::path::shutdown();
 
     return 0;
@@ -689,6 +1174,7 @@ static int pathfinder_remove_node(lua_State* L)
     DM_LUA_STACK_CHECK(L, 0);
     uint32_t node_id = luaL_checkint(L, 1);
     pathfinder::path::remove_node(node_id);
+    pathfinder::extension::bump_topology_version();
     return 0;
 }
 
@@ -698,6 +1184,7 @@ static int pathfinder_remove_gameobject_node(lua_State* L)
     uint32_t node_id = luaL_checkint(L, 1);
     pathfinder::extension::remove_gameobject_node(node_id);
     pathfinder::path::remove_node(node_id);
+    pathfinder::extension::bump_topology_version();
     return 0;
 }
 
@@ -782,6 +1269,7 @@ static int pathfinder_remove_edge(lua_State* L)
     {
         pathfinder::path::remove_edge(to, from);
     }
+    pathfinder::extension::bump_topology_version();
 
     return 0;
 }
@@ -878,17 +1366,29 @@ static int pathfinder_update_path_smoothing(lua_State* L)
     return 0;
 }
 
+static int pathfinder_set_smoothed_path_cache(lua_State* L)
+{
+    DM_LUA_STACK_CHECK(L, 0);
+
+    uint32_t max_entries = luaL_checkint(L, 1);
+    uint32_t max_points = luaL_checkint(L, 2);
+    pathfinder::extension::set_smoothed_path_cache(max_entries, max_points);
+
+    return 0;
+}
+
 static int pathfinder_smooth_path(lua_State* L)
 {
     DM_LUA_STACK_CHECK(L, 2);
+    DM_PROFILE("Pathfinder.SmoothPath");
 
     // IN <<-
     uint32_t smooth_id = luaL_checkinteger(L, 1);
     luaL_checktype(L, 2, LUA_TTABLE);
 
-    int                       path_count = (int)lua_objlen(L, 2);
-    dmArray<pathfinder::Vec2> waypoints;
-    waypoints.SetCapacity(path_count);
+    int                        path_count = (int)lua_objlen(L, 2);
+    bool                       flat = lua_toboolean(L, 3);
+    dmArray<pathfinder::Vec2>& waypoints = pathfinder::extension::get_arena_waypoints(path_count);
 
     for (int i = 1; i <= path_count; ++i)
     {
@@ -903,18 +1403,56 @@ static int pathfinder_smooth_path(lua_State* L)
         lua_pop(L, 1); // pop inner table
     }
 
-    dmArray<pathfinder::Vec2> smoothed_path;
-    uint32_t                  samples_per_segment = pathfinder::extension::get_smooth_sample_segment(smooth_id);
-
-    smoothed_path.SetCapacity(path_count * samples_per_segment);
+    uint32_t                   samples_per_segment = pathfinder::extension::get_smooth_sample_segment(smooth_id);
+    dmArray<pathfinder::Vec2>& smoothed_path = pathfinder::extension::get_arena_smoothed_path(pathfinder::smooth::calculate_smoothed_waypoint_capacity(waypoints.Size(), samples_per_segment));
 
+    uint64_t smooth_start = dmTime::GetMonotonicTime();
     pathfinder::extension::smooth_path_waypoint(smooth_id, waypoints, smoothed_path);
+    pathfinder::extension::record_smoothing(dmTime::GetMonotonicTime() - smooth_start);
 
     // OUT ->>
     lua_pushinteger(L, smoothed_path.Size());
 
     // Result table
-    push_smoothed_path_table(L, smoothed_path);
+    push_smoothed_path_table(L, smoothed_path, flat);
+
+    return 2;
+}
+
+static int pathfinder_resample_path(lua_State* L)
+{
+    DM_LUA_STACK_CHECK(L, 2);
+    DM_PROFILE("Pathfinder.ResamplePath");
+
+    // IN <<-
+    luaL_checktype(L, 1, LUA_TTABLE);
+    float spacing = luaL_checknumber(L, 2);
+    bool  flat = lua_toboolean(L, 3);
+
+    int                        path_count = (int)lua_objlen(L, 1);
+    dmArray<pathfinder::Vec2>& waypoints = pathfinder::extension::get_arena_waypoints(path_count);
+
+    for (int i = 1; i <= path_count; ++i)
+    {
+        lua_rawgeti(L, 1, i);
+
+        if (lua_istable(L, -1))
+        {
+            pathfinder::Vec2 pos = parse_vec2_from_table(L, -1);
+            waypoints.Push(pos);
+        }
+
+        lua_pop(L, 1); // pop inner table
+    }
+
+    dmArray<pathfinder::Vec2>& resampled = pathfinder::extension::get_arena_smoothed_path(0);
+    pathfinder::extension::resample_path(waypoints, spacing, resampled);
+
+    // OUT ->>
+    lua_pushinteger(L, resampled.Size());
+
+    // Result table
+    push_smoothed_path_table(L, resampled, flat);
 
     return 2;
 }
@@ -943,6 +1481,15 @@ static int pathfinder_resume_gameobject_node(lua_State* L)
     return 0;
 }
 
+static int pathfinder_set_gameobject_node_update_interval(lua_State* L)
+{
+    DM_LUA_STACK_CHECK(L, 0);
+    uint32_t node_id = luaL_checkinteger(L, 1);
+    uint32_t update_interval = luaL_checkinteger(L, 2);
+    pathfinder::extension::set_gameobject_node_update_interval(node_id, update_interval);
+    return 0;
+}
+
 static int pathfinder_set_update_frequency(lua_State* L)
 {
     DM_LUA_STACK_CHECK(L, 0);
@@ -986,6 +1533,40 @@ print("  Hit Rate:", stats.distance_cache.hit_rate .. "%")
 ---
 */
 
+// Helper function to create a Lua table from query stats
+static inline void push_query_stats_table(lua_State* L, const pathfinder::extension::QueryStats& stats)
+{
+    lua_createtable(L, 0, 13);
+    lua_pushinteger(L, stats.m_QueryCount);
+    lua_setfield(L, -2, "query_count");
+    lua_pushinteger(L, stats.m_SuccessCount);
+    lua_setfield(L, -2, "success_count");
+    lua_pushinteger(L, stats.m_NoPathCount);
+    lua_setfield(L, -2, "no_path_count");
+    lua_pushinteger(L, stats.m_GraphChangedCount);
+    lua_setfield(L, -2, "graph_changed_count");
+    lua_pushinteger(L, stats.m_ErrorCount);
+    lua_setfield(L, -2, "error_count");
+    lua_pushinteger(L, stats.m_SuccessCount > 0 ? stats.m_PathLength / stats.m_SuccessCount : 0);
+    lua_setfield(L, -2, "avg_path_length");
+    lua_pushinteger(L, stats.m_SmoothCount);
+    lua_setfield(L, -2, "smooth_count");
+    lua_pushinteger(L, stats.m_BidirectionalCount);
+    lua_setfield(L, -2, "bidirectional_count");
+    lua_pushinteger(L, stats.m_BidirectionalExpanded);
+    lua_setfield(L, -2, "bidirectional_expanded");
+
+    // Times in microseconds
+    lua_pushnumber(L, (lua_Number)stats.m_SearchTime);
+    lua_setfield(L, -2, "search_time");
+    lua_pushnumber(L, (lua_Number)stats.m_MaxSearchTime);
+    lua_setfield(L, -2, "max_search_time");
+    lua_pushnumber(L, stats.m_QueryCount > 0 ? (lua_Number)stats.m_SearchTime / stats.m_QueryCount : 0);
+    lua_setfield(L, -2, "avg_search_time");
+    lua_pushnumber(L, (lua_Number)stats.m_SmoothTime);
+    lua_setfield(L, -2, "smooth_time");
+}
+
 static int pathfinder_cache_stats(lua_State* L)
 {
     DM_LUA_STACK_CHECK(L, 1);
@@ -1011,7 +1592,13 @@ static int pathfinder_cache_stats(lua_State* L)
     // ============================================================================
     // CREATE RESULT TABLE
     // ============================================================================
-    lua_createtable(L, 0, 3); // main table (3 hash fields: path_cache, distance_cache, spatial_index)
+    uint32_t smooth_cache_entries;
+    uint32_t smooth_cache_capacity;
+    uint32_t smooth_cache_hits;
+    uint32_t smooth_cache_misses;
+    pathfinder::extension::get_smoothed_path_cache_stats(smooth_cache_entries, smooth_cache_capacity, smooth_cache_hits, smooth_cache_misses);
+
+    lua_createtable(L, 0, 5); // main table (5 hash fields: path_cache, smoothed_path_cache, distance_cache, spatial_index, queries)
 
     //  path_cache
     lua_createtable(L, 0, 3);
@@ -1025,6 +1612,22 @@ static int pathfinder_cache_stats(lua_State* L)
     // add to main table
     lua_setfield(L, -2, "path_cache");
 
+    //  smoothed_path_cache
+    lua_createtable(L, 0, 5);
+    lua_pushinteger(L, smooth_cache_entries);
+    lua_setfield(L, -2, "current_entries");
+    lua_pushinteger(L, smooth_cache_capacity);
+    lua_setfield(L, -2, "max_capacity");
+    lua_pushinteger(L, smooth_cache_hits);
+    lua_setfield(L, -2, "hit_count");
+    lua_pushinteger(L, smooth_cache_misses);
+    lua_setfield(L, -2, "miss_count");
+    lua_pushinteger(L, smooth_cache_hits + smooth_cache_misses > 0 ? (uint32_t)(((uint64_t)smooth_cache_hits * 100) / (smooth_cache_hits + smooth_cache_misses)) : 0);
+    lua_setfield(L, -2, "hit_rate");
+
+    // add to main table
+    lua_setfield(L, -2, "smoothed_path_cache");
+
     //  distance_cache
     lua_createtable(L, 0, 4);
     lua_pushinteger(L, dist_cache_size);
@@ -1053,6 +1656,16 @@ static int pathfinder_cache_stats(lua_State* L)
     // add to main table
     lua_setfield(L, -2, "spatial_index");
 
+    // queries
+    lua_createtable(L, 0, 2);
+    push_query_stats_table(L, pathfinder::extension::get_frame_query_stats());
+    lua_setfield(L, -2, "last_frame");
+    push_query_stats_table(L, pathfinder::extension::get_total_query_stats());
+    lua_setfield(L, -2, "total");
+
+    // add to main table
+    lua_setfield(L, -2, "queries");
+
     return 1; // one table on stack
 }
 
@@ -1077,16 +1690,34 @@ static const luaL_reg Module_methods[] = {
     { "add_edges", pathfinder_add_edges },
     { "remove_edge", pathfinder_remove_edge },
 
+    // Graph snapshot
+    { "save_graph", pathfinder_save_graph },
+    { "load_graph", pathfinder_load_graph },
+
     // Path
     { "find_node_to_node", pathfinder_find_node_to_node_path },
     { "find_projected_to_node", pathfinder_find_projected_to_node_path },
     { "find_node_to_projected", pathfinder_find_node_to_projected_path },
     { "find_projected_to_projected", pathfinder_find_projected_to_projected_path },
+    { "find_paths_batch", pathfinder_find_paths_batch },
+    { "find_flow_field_path", pathfinder_find_flow_field_path },
+    { "set_flow_field_capacity", pathfinder_set_flow_field_capacity },
+    { "find_bidirectional_path", pathfinder_find_bidirectional_path },
+    { "set_bidirectional_threshold", pathfinder_set_bidirectional_threshold },
+
+    // Path requests
+    { "request_path", pathfinder_request_path },
+    { "cancel_path_request", pathfinder_cancel_path_request },
+    { "set_path_request_capacity", pathfinder_set_path_request_capacity },
+    { "set_path_request_budget", pathfinder_set_path_request_budget },
+    { "get_pending_path_request_count", pathfinder_get_pending_path_request_count },
 
     // Smooth
     { "smooth_path", pathfinder_smooth_path },
+    { "resample_path", pathfinder_resample_path },
     { "add_path_smoothing", pathfinder_add_path_smoothing },
     { "update_path_smoothing", pathfinder_update_path_smoothing },
+    { "set_smoothed_path_cache", pathfinder_set_smoothed_path_cache },
 
     // Gameobjects
     { "add_gameobject_node", pathfinder_add_gameobject_node },
@@ -1095,6 +1726,7 @@ static const luaL_reg Module_methods[] = {
     { "remove_gameobject_node", pathfinder_remove_gameobject_node },
     { "pause_gameobject_node", pathfinder_pause_gameobject_node },
     { "resume_gameobject_node", pathfinder_resume_gameobject_node },
+    { "set_gameobject_node_update_interval", pathfinder_set_gameobject_node_update_interval },
 
     // Update
     { "gameobject_update", pathfinder_set_gameobject_update },
@@ -1189,6 +1821,14 @@ static dmExtension::Result AppFinalizeGraphPathfinder(dmExtension::AppParams* pa
 static dmExtension::Result OnUpdateGraphPathfinder(dmExtension::Params* params)
 {
     pathfinder::extension::update();
+    dispatch_path_job_results();
+    return dmExtension::RESULT_OK;
+}
+
+static dmExtension::Result FinalizeGraphPathfinder(dmExtension::Params* params)
+{
+    // Callbacks are bound to this Lua context
+    clear_path_job_callbacks();
     return dmExtension::RESULT_OK;
 }
 
@@ -1198,4 +1838,4 @@ static dmExtension::Result OnUpdateGraphPathfinder(dmExtension::Params* params)
 
 // GraphPathfinder is the C++ symbol that holds all relevant extension data.
 // It must match the name field in the `ext.manifest`
-DM_DECLARE_EXTENSION(GraphPathfinder, LIB_NAME, AppInitializeGraphPathfinder, AppFinalizeGraphPathfinder, InitializeGraphPathfinder, OnUpdateGraphPathfinder, 0, 0)
+DM_DECLARE_EXTENSION(GraphPathfinder, LIB_NAME, AppInitializeGraphPathfinder, AppFinalizeGraphPathfinder, InitializeGraphPathfinder, OnUpdateGraphPathfinder, 0, FinalizeGraphPathfinder)
@@ -1,17 +1,22 @@
 
 #include <cstdint>
+#include <cstring>
+#include <cfloat>
 #include <pathfinder_extension.h>
 #include <dmsdk/dlib/hashtable.h>
 #include "dmsdk/dlib/log.h"
 #include "dmsdk/dlib/time.h"
+#include "dmsdk/dlib/profile.h"
 #include "dmsdk/gameobject/gameobject.h"
 #include "pathfinder_constants.h"
 #include "pathfinder_path.h"
 #include "pathfinder_smooth.h"
+#include "pathfinder_math.h"
 
 #include "pathfinder_cache.h"
 #include "pathfinder_distance_cache.h"
 #include "pathfinder_spatial_index.h"
+#include "pathfinder_heap.h"
 
 namespace pathfinder
 {
@@ -24,12 +29,35 @@ namespace pathfinder
         {
             pathfinder::PathSmoothStyle       m_PathSmoothStyle;
             navigation::AgentPathSmoothConfig m_PathSmoothConfig;
+            uint32_t                          m_Version; // Bumped by update_smooth_config, part of the smoothed path cache key
         } SmoothConfig;
 
         const static uint8_t               MAX_SMOOTH_CONFIG = 64;
         static dmHashTable16<SmoothConfig> m_SmoothConfigs;
         static uint32_t                    m_SmoothId = 0;
 
+        //==========================================================
+        // Smoothed path cache
+        //==========================================================
+        typedef struct SmoothCacheEntry
+        {
+            uint64_t m_Key;           // Hash of (node IDs, node positions, smooth_id, config version)
+            uint32_t m_SmoothId;      // Checked on a hit, together with the node IDs
+            uint32_t m_ConfigVersion; // Smooth config version the points were built with
+            uint32_t m_NodeCount;     // Number of path nodes
+            uint32_t m_Length;        // Number of smoothed points
+            uint32_t m_LastUsed;      // Use counter, for least recently used eviction
+        } SmoothCacheEntry;
+
+        static dmArray<SmoothCacheEntry> m_SmoothCacheEntries;
+        static dmHashTable64<uint32_t>   m_SmoothCacheIndex;  // Key -> entry slot
+        static dmArray<Vec2>             m_SmoothCachePoints; // m_SmoothCacheMaxPoints per slot
+        static dmArray<uint32_t>         m_SmoothCacheNodes;  // m_SmoothCacheMaxPoints path node IDs per slot
+        static uint32_t                  m_SmoothCacheMaxPoints = 0;
+        static uint32_t                  m_SmoothCacheUseCounter = 0;
+        static uint32_t                  m_SmoothCacheHits = 0;
+        static uint32_t                  m_SmoothCacheMisses = 0;
+
         //==========================================================
         // Gameobjects
         //==========================================================
@@ -42,14 +70,135 @@ namespace pathfinder
         typedef struct Gameobject
         {
             int32_t                 m_NodeId;
-            dmVMath::Point3         m_Position;
+            dmVMath::Point3         m_Position;           // Last position synced to the node
             dmGameObject::HInstance m_GameObjectInstance;
             bool                    m_UseWorldPosition;
             GameobjectState         m_GameobjectState;
+            uint32_t                m_UpdateInterval;     // Sync every N update steps (1 = every step)
+            uint32_t                m_StepsUntilUpdate;   // Steps left until the next sync
         } Gameobject;
 
         static dmHashTable32<Gameobject> m_Gameobjects;
 
+        //==========================================================
+        // Stats
+        //==========================================================
+        static QueryStats m_FrameQueryStats;     // Accumulating for the current frame
+        static QueryStats m_LastFrameQueryStats; // Last completed frame
+        static QueryStats m_TotalQueryStats;     // Since init or reset_query_stats()
+
+        //==========================================================
+        // Result arena
+        //==========================================================
+        static dmArray<uint32_t> m_ArenaPath;         // Raw path output, shared by all find calls
+        static dmArray<Vec2>     m_ArenaWaypoints;    // Projected path waypoints (entry/exit + nodes)
+        static dmArray<Vec2>     m_ArenaSmoothedPath; // Smoothing output
+        static dmArray<float>    m_ArenaArcLengths;   // Cumulative arc-length table for resample_path
+        const static uint32_t    MAX_RESAMPLE_STEPS = UINT16_MAX;
+
+        //==========================================================
+        // Jobs
+        //==========================================================
+        typedef struct PathJob
+        {
+            uint32_t    m_Ticket;
+            PathRequest m_Request;
+            bool        m_Cancelled;
+        } PathJob;
+
+        const static uint32_t         DEFAULT_PATH_JOB_CAPACITY = 128;
+        static dmArray<PathJob>       m_PathJobs;               // Ring buffer of pending jobs
+        static uint32_t               m_PathJobHead = 0;        // Index of the oldest pending job
+        static uint32_t               m_PathJobCount = 0;       // Number of pending jobs
+        static uint32_t               m_NextTicket = 1;         // 0 is reserved for "no ticket"
+        static uint32_t               m_PathJobBudgetCount = 0; // Max jobs per update (0 = unlimited)
+        static uint32_t               m_PathJobBudgetTime = 0;  // Max microseconds per update (0 = unlimited)
+        static dmArray<PathJobResult> m_PathJobResults;         // Results of the last process_path_jobs()
+        static dmArray<uint32_t>      m_PathJobNodes;           // Raw paths of the last process_path_jobs()
+        static dmArray<Vec2>          m_PathJobPoints;          // Smoothed paths of the last process_path_jobs()
+
+        //==========================================================
+        // Flow fields
+        //==========================================================
+        typedef struct FlowField
+        {
+            uint32_t           m_GoalNodeId; // INVALID_ID if the slot is free
+            uint32_t           m_Version;    // Topology version the field was built against
+            uint32_t           m_LastUsed;   // Use counter, for least recently used eviction
+        } FlowField;
+
+        const static uint32_t     DEFAULT_FLOW_FIELD_CAPACITY = 4;
+        static uint32_t           m_MaxNodes = 0;
+        static uint32_t           m_FlowFieldCapacity = DEFAULT_FLOW_FIELD_CAPACITY;
+        static uint32_t           m_FlowFieldUseCounter = 0;
+        static dmArray<FlowField> m_FlowFields;
+        static dmArray<uint32_t>  m_FlowNextHops;        // m_MaxNodes entries per field: next node towards the goal
+        static dmArray<float>     m_FlowDistances;       // m_MaxNodes entries per field: cost to the goal
+        static uint32_t           m_TopologyVersion = 0; // Bumped by node/edge add and remove, see bump_topology_version()
+        static uint32_t           m_FlowEdgesVersion;    // Topology version of the adjacency
+        static bool               m_FlowEdgesValid = false;
+        static dmArray<uint32_t>  m_FlowReverseOffsets;  // Reverse adjacency (CSR): incoming edges of node n are
+        static dmArray<uint32_t>  m_FlowReverseFrom;     // [m_FlowReverseOffsets[n], m_FlowReverseOffsets[n + 1])
+        static dmArray<float>     m_FlowReverseCost;
+        static dmArray<uint32_t>  m_FlowForwardOffsets;  // Forward adjacency (CSR) into m_FlowEdges, same layout
+        static dmArray<EdgeInfo>  m_FlowEdges;           // All outgoing edges of the graph, grouped by source node
+        static dmArray<EdgeInfo>  m_FlowNodeEdges;       // Scratch: outgoing edges of one node
+        static heap::HeapBlock    m_FlowHeap;
+        static heap::HeapIndex    m_FlowHeapIndex;
+
+        //==========================================================
+        // Bidirectional search
+        //==========================================================
+        // Index 0 is the forward search from the start, 1 the backward search from the goal
+        static float              m_BidirectionalThreshold = 0.0f; // find_node_path() distance threshold (0 = off)
+        static heap::HeapBlock    m_BidirectionalHeaps[2];
+        static heap::HeapIndex    m_BidirectionalIndices[2];       // Also marks the nodes reached by each search
+        static dmArray<float>     m_BidirectionalCosts[2];         // Cost from the start / to the goal
+        static dmArray<uint32_t>  m_BidirectionalParents[2];       // Previous node towards the start / goal
+
+        //==========================================================
+        // Graph snapshot
+        //==========================================================
+        // Layout: header, node_count * { float x, float y }, edge_count * GraphSnapshotEdge.
+        // Native byte order; edges reference nodes by their index in the snapshot.
+        const static uint32_t GRAPH_SNAPSHOT_MAGIC = 0x47465047; // "GPFG"
+        const static uint32_t GRAPH_SNAPSHOT_VERSION = 1;
+
+        typedef struct GraphSnapshotHeader
+        {
+            uint32_t m_Magic;
+            uint32_t m_Version;
+            uint32_t m_NodeCount;
+            uint32_t m_EdgeCount;
+        } GraphSnapshotHeader;
+
+        typedef struct GraphSnapshotEdge
+        {
+            uint32_t m_From; // Snapshot node index
+            uint32_t m_To;   // Snapshot node index
+            float    m_Cost;
+        } GraphSnapshotEdge;
+
+        template <typename T>
+        static inline void ensure_capacity(dmArray<T>& array, uint32_t capacity)
+        {
+            if (array.Capacity() < capacity)
+            {
+                array.SetCapacity(capacity);
+            }
+        }
+
+        // For arrays that are appended to repeatedly: doubles, so n appends copy O(n) in total
+        template <typename T>
+        static inline void ensure_append_capacity(dmArray<T>& array, uint32_t count)
+        {
+            uint32_t required = array.Size() + count;
+            if (array.Capacity() < required)
+            {
+                array.SetCapacity(required > array.Capacity() * 2 ? required : array.Capacity() * 2);
+            }
+        }
+
         //==========================================================
         // Update
         //==========================================================
@@ -104,23 +253,40 @@ namespace pathfinder
             m_AccumFrameTime = m_AccumFrameTime - num_steps * fixed_dt;
         }
 
-        static inline void gameobject_iterate_callback(void* /*context*/, const uint32_t* /*key*/, Gameobject* gameobject)
+        // context: number of update steps since the last iteration
+        static inline void gameobject_iterate_callback(void* context, const uint32_t* /*key*/, Gameobject* gameobject)
         {
             if (gameobject->m_GameobjectState == GameobjectState::PAUSED)
             {
                 return;
             }
 
+            uint32_t num_steps = *(uint32_t*)context;
+            if (gameobject->m_StepsUntilUpdate > num_steps)
+            {
+                gameobject->m_StepsUntilUpdate -= num_steps;
+                return;
+            }
+            gameobject->m_StepsUntilUpdate = gameobject->m_UpdateInterval;
+
+            dmVMath::Point3 position;
             if (gameobject->m_UseWorldPosition)
             {
-                gameobject->m_Position = dmGameObject::GetWorldPosition(gameobject->m_GameObjectInstance);
+                position = dmGameObject::GetWorldPosition(gameobject->m_GameObjectInstance);
             }
             else
             {
-                gameobject->m_Position = dmGameObject::GetPosition(gameobject->m_GameObjectInstance);
+                position = dmGameObject::GetPosition(gameobject->m_GameObjectInstance);
+            }
+
+            // Only moved nodes pay for spatial index and cache invalidation
+            if (position.getX() == gameobject->m_Position.getX() && position.getY() == gameobject->m_Position.getY())
+            {
+                return;
             }
 
-            pathfinder::path::move_node(gameobject->m_NodeId, Vec2(gameobject->m_Position.getX(), gameobject->m_Position.getY()));
+            gameobject->m_Position = position;
+            pathfinder::path::move_node(gameobject->m_NodeId, Vec2(position.getX(), position.getY()));
         }
 
         //==========================================================
@@ -131,6 +297,7 @@ namespace pathfinder
         void init()
         {
             m_SmoothConfigs.SetCapacity(MAX_SMOOTH_CONFIG);
+            set_path_job_capacity(DEFAULT_PATH_JOB_CAPACITY);
         }
 
         void shutdown()
@@ -138,6 +305,13 @@ namespace pathfinder
             m_Gameobjects.Clear();
             m_SmoothConfigs.Clear();
             m_SmoothId = 0;
+            set_smoothed_path_cache(0, 0);
+            m_ArenaPath.SetCapacity(0);
+            m_ArenaWaypoints.SetCapacity(0);
+            m_ArenaSmoothedPath.SetCapacity(0);
+            m_ArenaArcLengths.SetCapacity(0);
+            clear_path_jobs();
+            clear_flow_fields();
         }
 
         void get_cache_stats(uint32_t& path_cache_entries,
@@ -173,12 +347,25 @@ namespace pathfinder
                 dmLogError("max_gameobject_nodes not defined on init or it is full. Size: %u", m_Gameobjects.Size());
                 return;
             }
+
+            // The core does not bounds-check node positions
+            if (node_id >= m_MaxNodes)
+            {
+                dmLogError("Invalid node id for gameobject node: %u", node_id);
+                return;
+            }
+
+            // Seed with the node's position, not the object's: a converted node or a
+            // world-position node can differ from it, and must sync on the first update
+            Vec2       node_position = pathfinder::path::get_node_position(node_id);
             Gameobject gameobject;
             gameobject.m_NodeId = node_id;
-            gameobject.m_Position = position;
+            gameobject.m_Position = dmVMath::Point3(node_position.x, node_position.y, position.getZ());
             gameobject.m_GameObjectInstance = instance;
             gameobject.m_GameobjectState = GameobjectState::RUNNING;
             gameobject.m_UseWorldPosition = use_world_position;
+            gameobject.m_UpdateInterval = 1;
+            gameobject.m_StepsUntilUpdate = 1;
 
             m_Gameobjects.Put(node_id, gameobject);
         }
@@ -210,6 +397,25 @@ namespace pathfinder
             gameobject->m_GameobjectState = GameobjectState::RUNNING;
         }
 
+        void set_gameobject_node_update_interval(uint32_t node_id, uint32_t update_interval)
+        {
+            Gameobject* gameobject = m_Gameobjects.Get(node_id);
+            if (gameobject == 0x0)
+            {
+                dmLogWarning("Cannot set update interval of gameobject node %u: not found", node_id);
+                return;
+            }
+
+            if (update_interval == 0)
+            {
+                update_interval = 1;
+            }
+
+            // Spread nodes with the same interval over different steps
+            gameobject->m_UpdateInterval = update_interval;
+            gameobject->m_StepsUntilUpdate = 1 + node_id % update_interval;
+        }
+
         //==========================================================
         // Update
         //==========================================================
@@ -224,7 +430,7 @@ namespace pathfinder
             m_UpdateFrequency = update_frequency;
         }
 
-        void update()
+        static void update_gameobjects()
         {
             // If paused or not set
             if (!m_UpdateLoopState || m_Gameobjects.Empty())
@@ -236,10 +442,29 @@ namespace pathfinder
             uint32_t num_steps; // Number of times to loop over the StepFrame function
 
             calc_timestep(step_dt, num_steps);
-            for (uint32_t i = 0; i < num_steps; ++i)
+            if (num_steps == 0)
             {
-                m_Gameobjects.Iterate(gameobject_iterate_callback, (void*)0x0);
+                return;
             }
+
+            // Game objects do not move between the steps of one frame, so a single pass covers them all
+            DM_PROFILE("Pathfinder.UpdateGameobjects");
+            m_Gameobjects.Iterate(gameobject_iterate_callback, (void*)&num_steps);
+        }
+
+        void update()
+        {
+            DM_PROFILE("Pathfinder.Update");
+
+            // Queries made since the last update belong to the frame that just ended
+            m_LastFrameQueryStats = m_FrameQueryStats;
+            memset(&m_FrameQueryStats, 0, sizeof(QueryStats));
+
+            reset_result_arena();
+
+            // Sync gameobject nodes first, so queued jobs search the current graph
+            update_gameobjects();
+            process_path_jobs();
         }
 
         //==========================================================
@@ -257,6 +482,7 @@ namespace pathfinder
             SmoothConfig smooth_config;
             smooth_config.m_PathSmoothStyle = (pathfinder::PathSmoothStyle)path_style;
             smooth_config.m_PathSmoothConfig = path_smooth_config;
+            smooth_config.m_Version = 0;
 
             m_SmoothId++;
             m_SmoothConfigs.Put(m_SmoothId, smooth_config);
@@ -274,6 +500,7 @@ namespace pathfinder
 
             smooth_config->m_PathSmoothStyle = (pathfinder::PathSmoothStyle)path_style;
             smooth_config->m_PathSmoothConfig = path_smooth_config;
+            smooth_config->m_Version++; // Cached smoothed paths of the old config no longer match
         }
 
         uint32_t get_smooth_sample_segment(uint32_t smooth_id)
@@ -287,15 +514,138 @@ namespace pathfinder
             return smooth_config->m_PathSmoothConfig.m_SampleSegment;
         }
 
-        void smooth_path(uint32_t smooth_id, dmArray<uint32_t>& path, dmArray<Vec2>& smoothed_path)
+        // FNV-1a over the node sequence and the node positions. Positions are what smoothing reads;
+        // node versions are not enough, since a removed node's slot is reused by add_node with the same version.
+        static inline uint64_t smooth_cache_key(const dmArray<uint32_t>& path, uint32_t smooth_id, uint32_t config_version)
         {
-            SmoothConfig* smooth_config = m_SmoothConfigs.Get(smooth_id);
-            if (smooth_config == 0x0)
+            const uint64_t prime = 1099511628211ULL;
+            uint64_t       hash = 14695981039346656037ULL;
+
+            hash = (hash ^ smooth_id) * prime;
+            hash = (hash ^ config_version) * prime;
+            hash = (hash ^ path.Size()) * prime;
+
+            for (uint32_t i = 0; i < path.Size(); ++i)
+            {
+                uint32_t node_id = path[i];
+                Vec2     position = pathfinder::path::get_node_position(node_id);
+                uint32_t x_bits;
+                uint32_t y_bits;
+                memcpy(&x_bits, &position.x, sizeof(uint32_t));
+                memcpy(&y_bits, &position.y, sizeof(uint32_t));
+
+                hash = (hash ^ node_id) * prime;
+                hash = (hash ^ x_bits) * prime;
+                hash = (hash ^ y_bits) * prime;
+            }
+            return hash;
+        }
+
+        void set_smoothed_path_cache(uint32_t max_entries, uint32_t max_points)
+        {
+            m_SmoothCacheEntries.SetCapacity(max_entries);
+            m_SmoothCacheEntries.SetSize(0);
+            m_SmoothCacheIndex.Clear();
+            // Hash table capacity can only grow; a larger index than entries is harmless
+            if (max_entries > m_SmoothCacheIndex.Capacity())
+            {
+                m_SmoothCacheIndex.SetCapacity(max_entries);
+            }
+            m_SmoothCachePoints.SetCapacity(max_entries * max_points);
+            m_SmoothCachePoints.SetSize(max_entries * max_points);
+            m_SmoothCacheNodes.SetCapacity(max_entries * max_points);
+            m_SmoothCacheNodes.SetSize(max_entries * max_points);
+            m_SmoothCacheMaxPoints = max_points;
+            m_SmoothCacheUseCounter = 0;
+            m_SmoothCacheHits = 0;
+            m_SmoothCacheMisses = 0;
+        }
+
+        void clear_smoothed_path_cache()
+        {
+            m_SmoothCacheEntries.SetSize(0);
+            m_SmoothCacheIndex.Clear();
+        }
+
+        void get_smoothed_path_cache_stats(uint32_t& entries, uint32_t& capacity, uint32_t& hits, uint32_t& misses)
+        {
+            entries = m_SmoothCacheEntries.Size();
+            capacity = m_SmoothCacheEntries.Capacity();
+            hits = m_SmoothCacheHits;
+            misses = m_SmoothCacheMisses;
+        }
+
+        // The key is only a hash: a hit must also match the smooth config and the node sequence
+        static inline bool smooth_cache_matches(const SmoothCacheEntry& entry, uint32_t slot, const dmArray<uint32_t>& path, uint32_t smooth_id, uint32_t config_version)
+        {
+            return entry.m_SmoothId == smooth_id && entry.m_ConfigVersion == config_version && entry.m_NodeCount == path.Size() &&
+                   memcmp(m_SmoothCacheNodes.Begin() + slot * m_SmoothCacheMaxPoints, path.Begin(), path.Size() * sizeof(uint32_t)) == 0;
+        }
+
+        static bool smooth_cache_get(uint64_t key, const dmArray<uint32_t>& path, uint32_t smooth_id, uint32_t config_version, dmArray<Vec2>& smoothed_path)
+        {
+            uint32_t* slot = m_SmoothCacheIndex.Get(key);
+            if (slot == 0x0 || !smooth_cache_matches(m_SmoothCacheEntries[*slot], *slot, path, smooth_id, config_version))
+            {
+                m_SmoothCacheMisses++;
+                return false;
+            }
+
+            SmoothCacheEntry& entry = m_SmoothCacheEntries[*slot];
+            entry.m_LastUsed = ++m_SmoothCacheUseCounter;
+            m_SmoothCacheHits++;
+
+            ensure_capacity(smoothed_path, smoothed_path.Size() + entry.m_Length);
+            smoothed_path.PushArray(m_SmoothCachePoints.Begin() + *slot * m_SmoothCacheMaxPoints, entry.m_Length);
+            return true;
+        }
+
+        static void smooth_cache_put(uint64_t key, const dmArray<uint32_t>& path, uint32_t smooth_id, uint32_t config_version, const dmArray<Vec2>& smoothed_path)
+        {
+            if (smoothed_path.Size() > m_SmoothCacheMaxPoints || path.Size() > m_SmoothCacheMaxPoints)
             {
-                dmLogError("Invalid smooth_id %u: config not found", smooth_id);
                 return;
             }
 
+            // A colliding key replaces its entry in place, so the index never points at two slots
+            uint32_t  slot;
+            uint32_t* existing = m_SmoothCacheIndex.Get(key);
+            if (existing != 0x0)
+            {
+                slot = *existing;
+            }
+            else if (!m_SmoothCacheEntries.Full())
+            {
+                slot = m_SmoothCacheEntries.Size();
+                m_SmoothCacheEntries.SetSize(slot + 1);
+            }
+            else
+            {
+                slot = 0;
+                for (uint32_t i = 1; i < m_SmoothCacheEntries.Size(); ++i)
+                {
+                    if (m_SmoothCacheEntries[i].m_LastUsed < m_SmoothCacheEntries[slot].m_LastUsed)
+                    {
+                        slot = i;
+                    }
+                }
+                m_SmoothCacheIndex.Erase(m_SmoothCacheEntries[slot].m_Key);
+            }
+
+            SmoothCacheEntry& entry = m_SmoothCacheEntries[slot];
+            entry.m_Key = key;
+            entry.m_SmoothId = smooth_id;
+            entry.m_ConfigVersion = config_version;
+            entry.m_NodeCount = path.Size();
+            entry.m_Length = smoothed_path.Size();
+            entry.m_LastUsed = ++m_SmoothCacheUseCounter;
+            memcpy(m_SmoothCachePoints.Begin() + slot * m_SmoothCacheMaxPoints, smoothed_path.Begin(), entry.m_Length * sizeof(Vec2));
+            memcpy(m_SmoothCacheNodes.Begin() + slot * m_SmoothCacheMaxPoints, path.Begin(), entry.m_NodeCount * sizeof(uint32_t));
+            m_SmoothCacheIndex.Put(key, slot);
+        }
+
+        static void smooth_path_uncached(SmoothConfig* smooth_config, dmArray<uint32_t>& path, dmArray<Vec2>& smoothed_path)
+        {
             switch (smooth_config->m_PathSmoothStyle)
             {
                 case NONE:
@@ -318,6 +668,35 @@ namespace pathfinder
             }
         }
 
+        void smooth_path(uint32_t smooth_id, dmArray<uint32_t>& path, dmArray<Vec2>& smoothed_path)
+        {
+            SmoothConfig* smooth_config = m_SmoothConfigs.Get(smooth_id);
+            if (smooth_config == 0x0)
+            {
+                dmLogError("Invalid smooth_id %u: config not found", smooth_id);
+                return;
+            }
+
+            // Only an empty output can be cached as a whole
+            bool     use_cache = m_SmoothCacheEntries.Capacity() > 0 && smoothed_path.Size() == 0;
+            uint64_t key = 0;
+            if (use_cache)
+            {
+                key = smooth_cache_key(path, smooth_id, smooth_config->m_Version);
+                if (smooth_cache_get(key, path, smooth_id, smooth_config->m_Version, smoothed_path))
+                {
+                    return;
+                }
+            }
+
+            smooth_path_uncached(smooth_config, path, smoothed_path);
+
+            if (use_cache)
+            {
+                smooth_cache_put(key, path, smooth_id, smooth_config->m_Version, smoothed_path);
+            }
+        }
+
         void smooth_path_waypoint(uint32_t smooth_id, dmArray<Vec2>& waypoints, dmArray<Vec2>& smoothed_path)
         {
             SmoothConfig* smooth_config = m_SmoothConfigs.Get(smooth_id);
@@ -349,5 +728,1077 @@ namespace pathfinder
             }
         }
 
+        uint32_t resample_path(const dmArray<Vec2>& path, float spacing, dmArray<Vec2>& resampled)
+        {
+            if (!(spacing > 0.0f))
+            {
+                dmLogError("Invalid spacing %.2f: must be greater than 0", spacing);
+                return 0;
+            }
+
+            uint32_t count = path.Size();
+            if (count == 0)
+            {
+                return 0;
+            }
+
+            ensure_capacity(m_ArenaArcLengths, count);
+            m_ArenaArcLengths.SetSize(count);
+            float total = math::build_arc_length_table(path.Begin(), count, m_ArenaArcLengths.Begin());
+
+            // Bound the sample count before the float -> integer cast; also rejects NaN/inf lengths
+            float step_count = total / spacing;
+            if (!(step_count <= (float)MAX_RESAMPLE_STEPS))
+            {
+                dmLogError("Invalid spacing %f: path length %.1f would need more than %u samples", spacing, total, MAX_RESAMPLE_STEPS);
+                return 0;
+            }
+
+            // Evenly spaced samples, plus the exact end point when the spacing does not land on it
+            uint32_t steps = (uint32_t)step_count;
+            bool     push_end = steps * spacing < total;
+            uint32_t sample_count = steps + 1 + (push_end ? 1 : 0);
+            ensure_capacity(resampled, resampled.Size() + sample_count);
+
+            uint32_t cursor = 0;
+            for (uint32_t i = 0; i <= steps; ++i)
+            {
+                resampled.Push(math::sample_at_distance(path.Begin(), m_ArenaArcLengths.Begin(), count, i * spacing, &cursor));
+            }
+            if (push_end)
+            {
+                resampled.Push(path[count - 1]);
+            }
+
+            return sample_count;
+        }
+
+
+        //==========================================================
+        // Stats
+        //==========================================================
+
+        static inline void add_query(QueryStats& stats, PathStatus status, uint32_t path_length, uint64_t search_time)
+        {
+            stats.m_QueryCount++;
+            stats.m_SearchTime += search_time;
+            if (search_time > stats.m_MaxSearchTime)
+            {
+                stats.m_MaxSearchTime = search_time;
+            }
+
+            switch (status)
+            {
+                case pathfinder::SUCCESS:
+                    stats.m_SuccessCount++;
+                    stats.m_PathLength += path_length;
+                    break;
+                case pathfinder::ERROR_NO_PATH:
+                    stats.m_NoPathCount++;
+                    break;
+                case pathfinder::ERROR_GRAPH_CHANGED:
+                case pathfinder::ERROR_GRAPH_CHANGED_TOO_OFTEN:
+                    stats.m_GraphChangedCount++;
+                    break;
+                default:
+                    stats.m_ErrorCount++;
+                    break;
+            }
+        }
+
+        void record_query(PathStatus status, uint32_t path_length, uint64_t search_time)
+        {
+            add_query(m_FrameQueryStats, status, path_length, search_time);
+            add_query(m_TotalQueryStats, status, path_length, search_time);
+        }
+
+        void record_smoothing(uint64_t smooth_time)
+        {
+            m_FrameQueryStats.m_SmoothCount++;
+            m_FrameQueryStats.m_SmoothTime += smooth_time;
+            m_TotalQueryStats.m_SmoothCount++;
+            m_TotalQueryStats.m_SmoothTime += smooth_time;
+        }
+
+        void reset_query_stats()
+        {
+            memset(&m_FrameQueryStats, 0, sizeof(QueryStats));
+            memset(&m_LastFrameQueryStats, 0, sizeof(QueryStats));
+            memset(&m_TotalQueryStats, 0, sizeof(QueryStats));
+        }
+
+        const QueryStats& get_frame_query_stats()
+        {
+            return m_LastFrameQueryStats;
+        }
+
+        const QueryStats& get_total_query_stats()
+        {
+            return m_TotalQueryStats;
+        }
+
+        //==========================================================
+        // Result arena
+        //==========================================================
+
+        dmArray<uint32_t>& get_arena_path()
+        {
+            m_ArenaPath.SetSize(0);
+            return m_ArenaPath;
+        }
+
+        dmArray<Vec2>& get_arena_waypoints(uint32_t capacity)
+        {
+            m_ArenaWaypoints.SetSize(0);
+            ensure_capacity(m_ArenaWaypoints, capacity);
+            return m_ArenaWaypoints;
+        }
+
+        dmArray<Vec2>& get_arena_smoothed_path(uint32_t capacity)
+        {
+            m_ArenaSmoothedPath.SetSize(0);
+            ensure_capacity(m_ArenaSmoothedPath, capacity);
+            return m_ArenaSmoothedPath;
+        }
+
+        void reset_result_arena()
+        {
+            m_ArenaPath.SetSize(0);
+            m_ArenaWaypoints.SetSize(0);
+            m_ArenaSmoothedPath.SetSize(0);
+        }
+
+        //==========================================================
+        // Batch
+        //==========================================================
+
+        void find_paths_batch(const dmArray<PathRequest>& requests, dmArray<PathResult>& results, dmArray<Vec2>& points)
+        {
+            DM_PROFILE("Pathfinder.FindPathsBatch");
+
+            results.SetSize(0);
+            points.SetSize(0);
+            ensure_capacity(results, requests.Size());
+
+            for (uint32_t i = 0; i < requests.Size(); ++i)
+            {
+                const PathRequest& request = requests[i];
+
+                PathStatus         status;
+                dmArray<uint32_t>& path = get_arena_path();
+                uint64_t           search_start = dmTime::GetMonotonicTime();
+                uint32_t           path_length = find_node_path(request.m_StartNodeId, request.m_GoalNodeId, path, request.m_MaxPath, &status);
+                record_query(status, path_length, dmTime::GetMonotonicTime() - search_start);
+
+                PathResult result;
+                result.m_Status = status;
+                result.m_Offset = points.Size();
+                result.m_Length = 0;
+
+                if (status == pathfinder::SUCCESS && path_length > 0)
+                {
+                    if (request.m_SmoothId > 0)
+                    {
+                        uint32_t samples_per_segment = get_smooth_sample_segment(request.m_SmoothId);
+                        dmArray<Vec2>& smoothed_path = get_arena_smoothed_path(pathfinder::smooth::calculate_smoothed_path_capacity(path, samples_per_segment));
+
+                        uint64_t       smooth_start = dmTime::GetMonotonicTime();
+                        smooth_path(request.m_SmoothId, path, smoothed_path);
+                        record_smoothing(dmTime::GetMonotonicTime() - smooth_start);
+
+                        result.m_Length = smoothed_path.Size();
+                        ensure_append_capacity(points, result.m_Length);
+                        points.PushArray(smoothed_path.Begin(), result.m_Length);
+                    }
+                    else
+                    {
+                        result.m_Length = path_length;
+                        ensure_append_capacity(points, path_length);
+                        for (uint32_t j = 0; j < path_length; ++j)
+                        {
+                            points.Push(pathfinder::path::get_node_position(path[j]));
+                        }
+                    }
+                }
+
+                results.Push(result);
+            }
+        }
+
+        //==========================================================
+        // Jobs
+        //==========================================================
+
+        void set_path_job_capacity(uint32_t capacity)
+        {
+            if (m_PathJobCount > 0)
+            {
+                dmLogWarning("Cannot change path job capacity while %u jobs are pending", m_PathJobCount);
+                return;
+            }
+
+            m_PathJobs.SetCapacity(capacity);
+            m_PathJobs.SetSize(capacity);
+            m_PathJobResults.SetCapacity(capacity);
+            m_PathJobHead = 0;
+        }
+
+        uint32_t submit_path_job(const PathRequest& request)
+        {
+            if (m_PathJobCount >= m_PathJobs.Size())
+            {
+                dmLogError("Path job queue full. Size: %u", m_PathJobs.Size());
+                return 0;
+            }
+
+            uint32_t ticket = m_NextTicket++;
+            if (m_NextTicket == 0)
+            {
+                m_NextTicket = 1; // 0 is reserved for "no ticket"
+            }
+
+            PathJob& job = m_PathJobs[(m_PathJobHead + m_PathJobCount) % m_PathJobs.Size()];
+            job.m_Ticket = ticket;
+            job.m_Request = request;
+            job.m_Cancelled = false;
+            m_PathJobCount++;
+
+            return ticket;
+        }
+
+        bool cancel_path_job(uint32_t ticket)
+        {
+            for (uint32_t i = 0; i < m_PathJobCount; ++i)
+            {
+                PathJob& job = m_PathJobs[(m_PathJobHead + i) % m_PathJobs.Size()];
+                if (job.m_Ticket == ticket && !job.m_Cancelled)
+                {
+                    job.m_Cancelled = true;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void clear_path_jobs()
+        {
+            m_PathJobHead = 0;
+            m_PathJobCount = 0;
+            m_PathJobResults.SetSize(0);
+            m_PathJobNodes.SetSize(0);
+            m_PathJobPoints.SetSize(0);
+        }
+
+        void set_path_job_budget(uint32_t max_jobs, uint32_t max_time)
+        {
+            m_PathJobBudgetCount = max_jobs;
+            m_PathJobBudgetTime = max_time;
+        }
+
+        uint32_t get_pending_path_job_count()
+        {
+            return m_PathJobCount;
+        }
+
+        void process_path_jobs()
+        {
+            DM_PROFILE("Pathfinder.ProcessPathJobs");
+
+            m_PathJobResults.SetSize(0);
+            m_PathJobNodes.SetSize(0);
+            m_PathJobPoints.SetSize(0);
+
+            // At least one job runs every update, so the queue always drains
+            uint64_t start_time = dmTime::GetMonotonicTime();
+            uint32_t processed = 0;
+
+            while (m_PathJobCount > 0)
+            {
+                if (processed > 0)
+                {
+                    if (m_PathJobBudgetCount > 0 && processed >= m_PathJobBudgetCount)
+                    {
+                        break;
+                    }
+
+                    if (m_PathJobBudgetTime > 0 && dmTime::GetMonotonicTime() - start_time >= m_PathJobBudgetTime)
+                    {
+                        break;
+                    }
+                }
+
+                PathJob& job = m_PathJobs[m_PathJobHead];
+                m_PathJobHead = (m_PathJobHead + 1) % m_PathJobs.Size();
+                m_PathJobCount--;
+
+                if (job.m_Cancelled)
+                {
+                    continue;
+                }
+
+                processed++;
+
+                const PathRequest& request = job.m_Request;
+
+                PathStatus         status;
+                dmArray<uint32_t>& path = get_arena_path();
+                uint64_t           search_start = dmTime::GetMonotonicTime();
+                uint32_t           path_length = find_node_path(request.m_StartNodeId, request.m_GoalNodeId, path, request.m_MaxPath, &status);
+                record_query(status, path_length, dmTime::GetMonotonicTime() - search_start);
+
+                PathJobResult result;
+                result.m_Ticket = job.m_Ticket;
+                result.m_Status = status;
+                result.m_Smoothed = request.m_SmoothId > 0;
+                result.m_Offset = 0;
+                result.m_Length = 0;
+
+                if (status == pathfinder::SUCCESS && path_length > 0)
+                {
+                    if (result.m_Smoothed)
+                    {
+                        uint32_t samples_per_segment = get_smooth_sample_segment(request.m_SmoothId);
+                        dmArray<Vec2>& smoothed_path = get_arena_smoothed_path(pathfinder::smooth::calculate_smoothed_path_capacity(path, samples_per_segment));
+
+                        uint64_t       smooth_start = dmTime::GetMonotonicTime();
+                        smooth_path(request.m_SmoothId, path, smoothed_path);
+                        record_smoothing(dmTime::GetMonotonicTime() - smooth_start);
+
+                        result.m_Offset = m_PathJobPoints.Size();
+                        result.m_Length = smoothed_path.Size();
+                        ensure_append_capacity(m_PathJobPoints, result.m_Length);
+                        m_PathJobPoints.PushArray(smoothed_path.Begin(), result.m_Length);
+                    }
+                    else
+                    {
+                        result.m_Offset = m_PathJobNodes.Size();
+                        result.m_Length = path_length;
+                        ensure_append_capacity(m_PathJobNodes, path_length);
+                        m_PathJobNodes.PushArray(path.Begin(), path_length);
+                    }
+                }
+
+                ensure_append_capacity(m_PathJobResults, 1);
+                m_PathJobResults.Push(result);
+            }
+        }
+
+        const dmArray<PathJobResult>& get_path_job_results()
+        {
+            return m_PathJobResults;
+        }
+
+        const dmArray<uint32_t>& get_path_job_nodes()
+        {
+            return m_PathJobNodes;
+        }
+
+        const dmArray<Vec2>& get_path_job_points()
+        {
+            return m_PathJobPoints;
+        }
+
+        //==========================================================
+        // Flow fields
+        //==========================================================
+
+        // heap::m_CurrentVersion also changes on node moves and on the temporary virtual nodes of
+        // every projected query, neither of which changes edges or costs. Fields and adjacency are
+        // keyed on this counter instead, which only the graph editing bindings bump.
+        void bump_topology_version()
+        {
+            ++m_TopologyVersion;
+        }
+
+        void set_node_capacity(uint32_t max_nodes)
+        {
+            clear_flow_fields();
+            m_MaxNodes = max_nodes;
+        }
+
+        void set_flow_field_capacity(uint32_t capacity)
+        {
+            clear_flow_fields();
+            m_FlowFieldCapacity = capacity;
+        }
+
+        void clear_flow_fields()
+        {
+            m_FlowFields.SetCapacity(0);
+            m_FlowNextHops.SetCapacity(0);
+            m_FlowDistances.SetCapacity(0);
+            m_FlowReverseOffsets.SetCapacity(0);
+            m_FlowReverseFrom.SetCapacity(0);
+            m_FlowReverseCost.SetCapacity(0);
+            m_FlowForwardOffsets.SetCapacity(0);
+            m_FlowEdges.SetCapacity(0);
+            m_FlowNodeEdges.SetCapacity(0);
+            m_FlowHeap.m_Nodes.SetCapacity(0);
+            m_FlowHeap.m_Size = 0;
+            m_FlowHeap.m_Capacity = 0;
+            heap::index_shutdown(&m_FlowHeapIndex);
+            m_FlowEdgesValid = false;
+
+            // Bidirectional search shares the adjacency
+            for (uint32_t d = 0; d < 2; ++d)
+            {
+                m_BidirectionalHeaps[d].m_Nodes.SetCapacity(0);
+                m_BidirectionalHeaps[d].m_Size = 0;
+                m_BidirectionalHeaps[d].m_Capacity = 0;
+                heap::index_shutdown(&m_BidirectionalIndices[d]);
+                m_BidirectionalCosts[d].SetCapacity(0);
+                m_BidirectionalParents[d].SetCapacity(0);
+            }
+        }
+
+        // Slabs are allocated on first use, so the feature costs nothing when unused
+        static void flow_fields_init()
+        {
+            m_FlowFields.SetCapacity(m_FlowFieldCapacity);
+            m_FlowFields.SetSize(m_FlowFieldCapacity);
+            for (uint32_t i = 0; i < m_FlowFieldCapacity; ++i)
+            {
+                m_FlowFields[i].m_GoalNodeId = INVALID_ID;
+                m_FlowFields[i].m_LastUsed = 0;
+            }
+
+            m_FlowNextHops.SetCapacity(m_FlowFieldCapacity * m_MaxNodes);
+            m_FlowNextHops.SetSize(m_FlowFieldCapacity * m_MaxNodes);
+            m_FlowDistances.SetCapacity(m_FlowFieldCapacity * m_MaxNodes);
+            m_FlowDistances.SetSize(m_FlowFieldCapacity * m_MaxNodes);
+
+            m_FlowHeap.m_Nodes.SetCapacity(m_MaxNodes);
+            m_FlowHeap.m_Nodes.SetSize(m_MaxNodes);
+            m_FlowHeap.m_Size = 0;
+            m_FlowHeap.m_Capacity = m_MaxNodes;
+            heap::index_init(&m_FlowHeapIndex, m_MaxNodes);
+        }
+
+        // Forward and reverse adjacency in CSR layout, rebuilt only when the graph version changes
+        static void flow_fields_build_adjacency()
+        {
+            if (m_FlowEdgesValid && m_FlowEdgesVersion == m_TopologyVersion)
+            {
+                return;
+            }
+
+            DM_PROFILE("Pathfinder.FlowFieldAdjacency");
+
+            m_FlowEdges.SetSize(0);
+            for (uint32_t node_id = 0; node_id < m_MaxNodes; ++node_id)
+            {
+                m_FlowNodeEdges.SetSize(0);
+                uint32_t count = pathfinder::path::get_node_edges(node_id, &m_FlowNodeEdges, true, false);
+                if (count == 0)
+                {
+                    continue;
+                }
+                ensure_append_capacity(m_FlowEdges, m_FlowNodeEdges.Size());
+                m_FlowEdges.PushArray(m_FlowNodeEdges.Begin(), m_FlowNodeEdges.Size());
+            }
+
+            // Edges are already grouped by source
+            m_FlowForwardOffsets.SetCapacity(m_MaxNodes + 1);
+            m_FlowForwardOffsets.SetSize(m_MaxNodes + 1);
+            memset(m_FlowForwardOffsets.Begin(), 0, (m_MaxNodes + 1) * sizeof(uint32_t));
+
+            for (uint32_t i = 0; i < m_FlowEdges.Size(); ++i)
+            {
+                m_FlowForwardOffsets[m_FlowEdges[i].m_From + 1]++;
+            }
+            for (uint32_t n = 0; n < m_MaxNodes; ++n)
+            {
+                m_FlowForwardOffsets[n + 1] += m_FlowForwardOffsets[n];
+            }
+
+            // Counting sort by destination
+            m_FlowReverseOffsets.SetCapacity(m_MaxNodes + 1);
+            m_FlowReverseOffsets.SetSize(m_MaxNodes + 1);
+            memset(m_FlowReverseOffsets.Begin(), 0, (m_MaxNodes + 1) * sizeof(uint32_t));
+
+            for (uint32_t i = 0; i < m_FlowEdges.Size(); ++i)
+            {
+                m_FlowReverseOffsets[m_FlowEdges[i].m_To + 1]++;
+            }
+            for (uint32_t n = 0; n < m_MaxNodes; ++n)
+            {
+                m_FlowReverseOffsets[n + 1] += m_FlowReverseOffsets[n];
+            }
+
+            uint32_t edge_count = m_FlowEdges.Size();
+            ensure_capacity(m_FlowReverseFrom, edge_count);
+            m_FlowReverseFrom.SetSize(edge_count);
+            ensure_capacity(m_FlowReverseCost, edge_count);
+            m_FlowReverseCost.SetSize(edge_count);
+
+            // Offsets double as per-node write cursors
+            for (uint32_t i = 0; i < m_FlowEdges.Size(); ++i)
+            {
+                const EdgeInfo& edge = m_FlowEdges[i];
+                uint32_t        slot = m_FlowReverseOffsets[edge.m_To]++;
+                m_FlowReverseFrom[slot] = edge.m_From;
+                m_FlowReverseCost[slot] = edge.m_Cost;
+            }
+
+            // Shift offsets back after using them as cursors
+            for (uint32_t n = m_MaxNodes; n > 0; --n)
+            {
+                m_FlowReverseOffsets[n] = m_FlowReverseOffsets[n - 1];
+            }
+            m_FlowReverseOffsets[0] = 0;
+
+            m_FlowEdgesVersion = m_TopologyVersion;
+            m_FlowEdgesValid = true;
+        }
+
+        // Reverse Dijkstra from the goal over incoming edges
+        static void flow_field_build(uint32_t slot, uint32_t goal_node_id)
+        {
+            DM_PROFILE("Pathfinder.FlowFieldBuild");
+
+            flow_fields_build_adjacency();
+
+            uint32_t* next_hops = m_FlowNextHops.Begin() + slot * m_MaxNodes;
+            float*    distances = m_FlowDistances.Begin() + slot * m_MaxNodes;
+
+            for (uint32_t n = 0; n < m_MaxNodes; ++n)
+            {
+                next_hops[n] = INVALID_ID;
+                distances[n] = FLT_MAX;
+            }
+
+            m_FlowHeap.m_Size = 0;
+            heap::index_clear(&m_FlowHeapIndex);
+
+            distances[goal_node_id] = 0.0f;
+            next_hops[goal_node_id] = goal_node_id;
+            heap::push_indexed(&m_FlowHeap, &m_FlowHeapIndex, goal_node_id, 0.0f);
+
+            // Every node enters the heap at most once, so it cannot overflow
+            while (!heap::is_empty(&m_FlowHeap))
+            {
+                uint32_t current = heap::pop_indexed(&m_FlowHeap, &m_FlowHeapIndex);
+                float    current_distance = distances[current];
+
+                for (uint32_t e = m_FlowReverseOffsets[current]; e < m_FlowReverseOffsets[current + 1]; ++e)
+                {
+                    uint32_t from = m_FlowReverseFrom[e];
+                    float    distance = current_distance + m_FlowReverseCost[e];
+                    if (distance < distances[from])
+                    {
+                        distances[from] = distance;
+                        next_hops[from] = current;
+                        heap::push_or_decrease_key(&m_FlowHeap, &m_FlowHeapIndex, from, distance);
+                    }
+                }
+            }
+
+            FlowField& field = m_FlowFields[slot];
+            field.m_GoalNodeId = goal_node_id;
+            field.m_Version = m_TopologyVersion;
+        }
+
+        // Inactive nodes never have edges in the flat arrays
+        static inline bool flow_node_has_edges(uint32_t node_id)
+        {
+            return m_FlowForwardOffsets[node_id] != m_FlowForwardOffsets[node_id + 1] || m_FlowReverseOffsets[node_id] != m_FlowReverseOffsets[node_id + 1];
+        }
+
+        // Returns the slot of an up-to-date field for the goal, building or evicting as needed
+        static uint32_t flow_field_acquire(uint32_t goal_node_id)
+        {
+            if (m_FlowFields.Size() == 0)
+            {
+                flow_fields_init();
+            }
+
+            uint32_t slot = INVALID_ID;
+            uint32_t oldest = 0;
+            for (uint32_t i = 0; i < m_FlowFields.Size(); ++i)
+            {
+                if (m_FlowFields[i].m_GoalNodeId == goal_node_id)
+                {
+                    slot = i;
+                    break;
+                }
+                if (m_FlowFields[i].m_LastUsed < m_FlowFields[oldest].m_LastUsed)
+                {
+                    oldest = i;
+                }
+            }
+
+            if (slot == INVALID_ID)
+            {
+                slot = oldest;
+                flow_field_build(slot, goal_node_id);
+            }
+            else if (m_FlowFields[slot].m_Version != m_TopologyVersion)
+            {
+                flow_field_build(slot, goal_node_id);
+            }
+
+            m_FlowFields[slot].m_LastUsed = ++m_FlowFieldUseCounter;
+            return slot;
+        }
+
+        uint32_t find_flow_field_path(uint32_t start_node_id, uint32_t goal_node_id, dmArray<uint32_t>& path, uint32_t max_path, PathStatus* status)
+        {
+            if (m_FlowFieldCapacity == 0 || m_MaxNodes == 0)
+            {
+                dmLogError("Flow fields are not available. Capacity: %u", m_FlowFieldCapacity);
+                *status = ERROR_NO_PATH;
+                return 0;
+            }
+
+            if (start_node_id >= m_MaxNodes)
+            {
+                *status = ERROR_START_NODE_INVALID;
+                return 0;
+            }
+
+            if (goal_node_id >= m_MaxNodes)
+            {
+                *status = ERROR_GOAL_NODE_INVALID;
+                return 0;
+            }
+
+            if (start_node_id == goal_node_id)
+            {
+                *status = ERROR_START_GOAL_NODE_SAME;
+                return 0;
+            }
+
+            // Same as bidirectional search: let the core report inactive nodes
+            // instead of building (and evicting) a field for them
+            flow_fields_build_adjacency();
+            if (!flow_node_has_edges(start_node_id) || !flow_node_has_edges(goal_node_id))
+            {
+                return pathfinder::path::find_path(start_node_id, goal_node_id, &path, max_path, status);
+            }
+
+            uint32_t        slot = flow_field_acquire(goal_node_id);
+            const uint32_t* next_hops = m_FlowNextHops.Begin() + slot * m_MaxNodes;
+
+            if (next_hops[start_node_id] == INVALID_ID)
+            {
+                *status = ERROR_NO_PATH;
+                return 0;
+            }
+
+            // Walk next hops: O(path length)
+            ensure_capacity(path, max_path);
+            uint32_t current = start_node_id;
+            while (true)
+            {
+                if (path.Size() >= max_path)
+                {
+                    path.SetSize(0);
+                    *status = ERROR_PATH_TOO_LONG;
+                    return 0;
+                }
+
+                path.Push(current);
+                if (current == goal_node_id)
+                {
+                    break;
+                }
+                current = next_hops[current];
+            }
+
+            *status = SUCCESS;
+            return path.Size();
+        }
+
+        //==========================================================
+        // Bidirectional search
+        //==========================================================
+
+        void set_bidirectional_threshold(float distance)
+        {
+            m_BidirectionalThreshold = distance;
+        }
+
+        static void bidirectional_init()
+        {
+            for (uint32_t d = 0; d < 2; ++d)
+            {
+                m_BidirectionalHeaps[d].m_Nodes.SetCapacity(m_MaxNodes);
+                m_BidirectionalHeaps[d].m_Nodes.SetSize(m_MaxNodes);
+                m_BidirectionalHeaps[d].m_Size = 0;
+                m_BidirectionalHeaps[d].m_Capacity = m_MaxNodes;
+                heap::index_init(&m_BidirectionalIndices[d], m_MaxNodes);
+                m_BidirectionalCosts[d].SetCapacity(m_MaxNodes);
+                m_BidirectionalCosts[d].SetSize(m_MaxNodes);
+                m_BidirectionalParents[d].SetCapacity(m_MaxNodes);
+                m_BidirectionalParents[d].SetSize(m_MaxNodes);
+            }
+        }
+
+        // Pushed at least once during the current search
+        static inline bool bidirectional_reached(uint32_t direction, uint32_t node_id)
+        {
+            const heap::HeapIndex& index = m_BidirectionalIndices[direction];
+            return index.m_Generations[node_id] == index.m_Generation;
+        }
+
+        // Average potential: p_f(v) = (h(v, goal) - h(v, start)) / 2 and p_r = -p_f.
+        // Both searches see the same reduced edge costs, so the meeting rule below is exact.
+        static inline float bidirectional_potential(uint32_t direction, uint32_t node_id, const Vec2 start_position, const Vec2 goal_position)
+        {
+            Vec2  position = pathfinder::path::get_node_position(node_id);
+            float potential = 0.5f * (math::distance(position, goal_position) - math::distance(position, start_position));
+            return direction == 0 ? potential : -potential;
+        }
+
+        static inline void record_bidirectional(uint32_t expanded)
+        {
+            m_FrameQueryStats.m_BidirectionalCount++;
+            m_FrameQueryStats.m_BidirectionalExpanded += expanded;
+            m_TotalQueryStats.m_BidirectionalCount++;
+            m_TotalQueryStats.m_BidirectionalExpanded += expanded;
+        }
+
+        uint32_t find_bidirectional_path(uint32_t start_node_id, uint32_t goal_node_id, dmArray<uint32_t>& path, uint32_t max_path, PathStatus* status)
+        {
+            DM_PROFILE("Pathfinder.BidirectionalSearch");
+
+            if (start_node_id >= m_MaxNodes)
+            {
+                *status = ERROR_START_NODE_INVALID;
+                return 0;
+            }
+
+            if (goal_node_id >= m_MaxNodes)
+            {
+                *status = ERROR_GOAL_NODE_INVALID;
+                return 0;
+            }
+
+            if (start_node_id == goal_node_id)
+            {
+                *status = ERROR_START_GOAL_NODE_SAME;
+                return 0;
+            }
+
+            flow_fields_build_adjacency();
+            if (m_BidirectionalCosts[0].Size() != m_MaxNodes)
+            {
+                bidirectional_init();
+            }
+
+            // A node without edges is inactive or isolated. The core search tells
+            // the two apart (invalid node or no path) and returns at once for inactive nodes.
+            if (!flow_node_has_edges(start_node_id) || !flow_node_has_edges(goal_node_id))
+            {
+                return pathfinder::path::find_path(start_node_id, goal_node_id, &path, max_path, status);
+            }
+
+            // Share the core path cache, so repeated long routes stay cache hits
+            ensure_capacity(path, max_path);
+            path.SetSize(0);
+            uint32_t cached_length = pathfinder::cache::find_path(start_node_id, goal_node_id, &path, max_path);
+            if (cached_length != INVALID_ID && cached_length <= max_path)
+            {
+                path.SetSize(cached_length);
+                *status = SUCCESS;
+                return cached_length;
+            }
+
+            Vec2     start_position = pathfinder::path::get_node_position(start_node_id);
+            Vec2     goal_position = pathfinder::path::get_node_position(goal_node_id);
+            uint32_t roots[2] = { start_node_id, goal_node_id };
+
+            for (uint32_t d = 0; d < 2; ++d)
+            {
+                m_BidirectionalHeaps[d].m_Size = 0;
+                heap::index_clear(&m_BidirectionalIndices[d]);
+                m_BidirectionalCosts[d][roots[d]] = 0.0f;
+                m_BidirectionalParents[d][roots[d]] = INVALID_ID;
+                heap::push_indexed(&m_BidirectionalHeaps[d], &m_BidirectionalIndices[d], roots[d], bidirectional_potential(d, roots[d], start_position, goal_position));
+            }
+
+            float    best_cost = FLT_MAX;
+            uint32_t meeting_node = INVALID_ID;
+            uint32_t expanded = 0;
+
+            // Each node is in a heap at most once, so neither can overflow
+            while (!heap::is_empty(&m_BidirectionalHeaps[0]) && !heap::is_empty(&m_BidirectionalHeaps[1]))
+            {
+                // Stop once no path through either frontier can beat the best meeting
+                if (m_BidirectionalHeaps[0].m_Nodes[0].m_FScore + m_BidirectionalHeaps[1].m_Nodes[0].m_FScore >= best_cost)
+                {
+                    break;
+                }
+
+                // Expand the smaller frontier
+                uint32_t d = m_BidirectionalHeaps[0].m_Size <= m_BidirectionalHeaps[1].m_Size ? 0 : 1;
+                uint32_t other = 1 - d;
+                uint32_t current = heap::pop_indexed(&m_BidirectionalHeaps[d], &m_BidirectionalIndices[d]);
+                float    current_cost = m_BidirectionalCosts[d][current];
+                ++expanded;
+
+                uint32_t edge_begin = d == 0 ? m_FlowForwardOffsets[current] : m_FlowReverseOffsets[current];
+                uint32_t edge_end = d == 0 ? m_FlowForwardOffsets[current + 1] : m_FlowReverseOffsets[current + 1];
+                for (uint32_t e = edge_begin; e < edge_end; ++e)
+                {
+                    uint32_t next = d == 0 ? m_FlowEdges[e].m_To : m_FlowReverseFrom[e];
+                    float    cost = current_cost + (d == 0 ? m_FlowEdges[e].m_Cost : m_FlowReverseCost[e]);
+
+                    if (bidirectional_reached(d, next) && cost >= m_BidirectionalCosts[d][next])
+                    {
+                        continue;
+                    }
+
+                    m_BidirectionalCosts[d][next] = cost;
+                    m_BidirectionalParents[d][next] = current;
+                    heap::push_or_decrease_key(&m_BidirectionalHeaps[d], &m_BidirectionalIndices[d], next, cost + bidirectional_potential(d, next, start_position, goal_position));
+
+                    if (bidirectional_reached(other, next) && cost + m_BidirectionalCosts[other][next] < best_cost)
+                    {
+                        best_cost = cost + m_BidirectionalCosts[other][next];
+                        meeting_node = next;
+                    }
+                }
+            }
+
+            record_bidirectional(expanded);
+
+            if (meeting_node == INVALID_ID)
+            {
+                *status = ERROR_NO_PATH;
+                return 0;
+            }
+
+            // start .. meeting_node from the forward parents, then meeting_node .. goal
+            uint32_t forward_count = 0;
+            for (uint32_t n = meeting_node; n != INVALID_ID; n = m_BidirectionalParents[0][n])
+            {
+                ++forward_count;
+            }
+            uint32_t backward_count = 0;
+            for (uint32_t n = m_BidirectionalParents[1][meeting_node]; n != INVALID_ID; n = m_BidirectionalParents[1][n])
+            {
+                ++backward_count;
+            }
+
+            if (forward_count + backward_count > max_path)
+            {
+                *status = ERROR_PATH_TOO_LONG;
+                return 0;
+            }
+
+            ensure_capacity(path, forward_count + backward_count);
+            path.SetSize(forward_count);
+            uint32_t i = forward_count;
+            for (uint32_t n = meeting_node; n != INVALID_ID; n = m_BidirectionalParents[0][n])
+            {
+                path[--i] = n;
+            }
+            for (uint32_t n = m_BidirectionalParents[1][meeting_node]; n != INVALID_ID; n = m_BidirectionalParents[1][n])
+            {
+                path.Push(n);
+            }
+
+            pathfinder::cache::add_path(start_node_id, goal_node_id, &path, path.Size());
+
+            *status = SUCCESS;
+            return path.Size();
+        }
+
+        uint32_t find_node_path(uint32_t start_node_id, uint32_t goal_node_id, dmArray<uint32_t>& path, uint32_t max_path, PathStatus* status)
+        {
+            if (m_BidirectionalThreshold > 0.0f && start_node_id < m_MaxNodes && goal_node_id < m_MaxNodes &&
+                math::distance(pathfinder::path::get_node_position(start_node_id), pathfinder::path::get_node_position(goal_node_id)) >= m_BidirectionalThreshold)
+            {
+                return find_bidirectional_path(start_node_id, goal_node_id, path, max_path, status);
+            }
+            return pathfinder::path::find_path(start_node_id, goal_node_id, &path, max_path, status);
+        }
+
+        //==========================================================
+        // Graph snapshot
+        //==========================================================
+
+        static inline void snapshot_write(dmArray<uint8_t>& out, const void* data, uint32_t size)
+        {
+            uint32_t required = out.Size() + size;
+            if (out.Capacity() < required)
+            {
+                out.SetCapacity(required > out.Capacity() * 2 ? required : out.Capacity() * 2);
+            }
+            memcpy(out.End(), data, size);
+            out.SetSize(required);
+        }
+
+        void save_graph(const dmArray<uint32_t>& node_ids, dmArray<uint8_t>& out)
+        {
+            DM_PROFILE("Pathfinder.SaveGraph");
+
+            out.SetSize(0);
+
+            // Node id -> snapshot index, and the unique node ids in snapshot order
+            dmArray<uint32_t> saved_ids;
+            saved_ids.SetCapacity(node_ids.Size());
+            dmArray<uint32_t> indices;
+            indices.SetCapacity(m_MaxNodes);
+            indices.SetSize(m_MaxNodes);
+            for (uint32_t n = 0; n < m_MaxNodes; ++n)
+            {
+                indices[n] = INVALID_ID;
+            }
+
+            GraphSnapshotHeader header;
+            header.m_Magic = GRAPH_SNAPSHOT_MAGIC;
+            header.m_Version = GRAPH_SNAPSHOT_VERSION;
+            header.m_NodeCount = 0;
+            header.m_EdgeCount = 0;
+            ensure_capacity(out, sizeof(header) + node_ids.Size() * 2 * sizeof(float));
+            snapshot_write(out, &header, sizeof(header));
+
+            for (uint32_t i = 0; i < node_ids.Size(); ++i)
+            {
+                uint32_t node_id = node_ids[i];
+                if (node_id >= m_MaxNodes)
+                {
+                    dmLogError("Invalid node_id %u: skipped", node_id);
+                    continue;
+                }
+                if (indices[node_id] != INVALID_ID)
+                {
+                    continue; // Duplicate
+                }
+
+                Vec2 position = pathfinder::path::get_node_position(node_id);
+                snapshot_write(out, &position.x, sizeof(float));
+                snapshot_write(out, &position.y, sizeof(float));
+                indices[node_id] = header.m_NodeCount++;
+                saved_ids.Push(node_id);
+            }
+
+            // Each directed edge is stored once; edges to nodes outside the snapshot are dropped
+            dmArray<EdgeInfo> node_edges;
+            for (uint32_t i = 0; i < saved_ids.Size(); ++i)
+            {
+                uint32_t node_id = saved_ids[i];
+                node_edges.SetSize(0);
+                pathfinder::path::get_node_edges(node_id, &node_edges, true, false);
+                for (uint32_t e = 0; e < node_edges.Size(); ++e)
+                {
+                    const EdgeInfo& edge = node_edges[e];
+                    if (edge.m_To >= m_MaxNodes || indices[edge.m_To] == INVALID_ID)
+                    {
+                        continue;
+                    }
+
+                    GraphSnapshotEdge snapshot_edge;
+                    snapshot_edge.m_From = i;
+                    snapshot_edge.m_To = indices[edge.m_To];
+                    snapshot_edge.m_Cost = edge.m_Cost;
+                    snapshot_write(out, &snapshot_edge, sizeof(snapshot_edge));
+                    header.m_EdgeCount++;
+                }
+            }
+
+            memcpy(out.Begin(), &header, sizeof(header));
+        }
+
+        bool load_graph(const uint8_t* data, uint32_t size, dmArray<uint32_t>& node_ids, uint32_t& failed_edges)
+        {
+            DM_PROFILE("Pathfinder.LoadGraph");
+
+            node_ids.SetSize(0);
+            failed_edges = 0;
+
+            GraphSnapshotHeader header;
+            if (size < sizeof(header))
+            {
+                dmLogError("Invalid graph snapshot: %u bytes is smaller than the header", size);
+                return false;
+            }
+            memcpy(&header, data, sizeof(header));
+
+            if (header.m_Magic != GRAPH_SNAPSHOT_MAGIC)
+            {
+                dmLogError("Invalid graph snapshot: bad magic 0x%08x", header.m_Magic);
+                return false;
+            }
+            if (header.m_Version != GRAPH_SNAPSHOT_VERSION)
+            {
+                dmLogError("Unsupported graph snapshot version %u (expected %u)", header.m_Version, GRAPH_SNAPSHOT_VERSION);
+                return false;
+            }
+
+            uint64_t expected_size = sizeof(header) + (uint64_t)header.m_NodeCount * 2 * sizeof(float) + (uint64_t)header.m_EdgeCount * sizeof(GraphSnapshotEdge);
+            if (expected_size != size)
+            {
+                dmLogError("Invalid graph snapshot: %u bytes, expected %llu", size, (unsigned long long)expected_size);
+                return false;
+            }
+
+            // Free slots are not visible from here; a full graph is caught and rolled back below
+            if (header.m_NodeCount > m_MaxNodes)
+            {
+                dmLogError("Graph snapshot has %u nodes, max_nodes is %u", header.m_NodeCount, m_MaxNodes);
+                return false;
+            }
+
+            // Validate edges first, so an invalid snapshot adds nothing
+            const uint8_t* edges = data + sizeof(header) + header.m_NodeCount * 2 * sizeof(float);
+            for (uint32_t i = 0; i < header.m_EdgeCount; ++i)
+            {
+                GraphSnapshotEdge edge;
+                memcpy(&edge, edges + i * sizeof(GraphSnapshotEdge), sizeof(edge));
+                if (edge.m_From >= header.m_NodeCount || edge.m_To >= header.m_NodeCount)
+                {
+                    dmLogError("Invalid graph snapshot: edge %u node index out of range (%u -> %u)", i, edge.m_From, edge.m_To);
+                    return false;
+                }
+            }
+
+            const uint8_t* cursor = data + sizeof(header);
+
+            ensure_capacity(node_ids, header.m_NodeCount);
+            for (uint32_t i = 0; i < header.m_NodeCount; ++i)
+            {
+                Vec2 position;
+                memcpy(&position.x, cursor, sizeof(float));
+                memcpy(&position.y, cursor + sizeof(float), sizeof(float));
+                cursor += 2 * sizeof(float);
+
+                PathStatus status;
+                uint32_t   node_id = pathfinder::path::add_node(position, &status);
+                if (status != SUCCESS)
+                {
+                    dmLogError("Graph snapshot node %u: x=%.1f, y=%.1f Failed (status: %d). Removing the %u nodes already added", i, position.x, position.y, status, node_ids.Size());
+                    for (uint32_t n = 0; n < node_ids.Size(); ++n)
+                    {
+                        pathfinder::path::remove_node(node_ids[n]);
+                    }
+                    node_ids.SetSize(0);
+                    bump_topology_version();
+                    return false;
+                }
+                node_ids.Push(node_id);
+            }
+
+            for (uint32_t i = 0; i < header.m_EdgeCount; ++i)
+            {
+                GraphSnapshotEdge edge;
+                memcpy(&edge, cursor, sizeof(edge));
+                cursor += sizeof(edge);
+
+                PathStatus status;
+                pathfinder::path::add_edge(node_ids[edge.m_From], node_ids[edge.m_To], edge.m_Cost, false, &status);
+                if (status != SUCCESS)
+                {
+                    dmLogError("Graph snapshot edge %u: from_node_id=%u, to_node_id=%u Failed (status: %d)", i, node_ids[edge.m_From], node_ids[edge.m_To], status);
+                    ++failed_edges;
+                }
+            }
+
+            bump_topology_version();
+            return true;
+        }
+
     } // namespace extension
-} // namespace pathfinder
\ No newline at end of file
+} // namespace pathfinder